@@ -0,0 +1,245 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_ACCEPT_DISTRIBUTOR_HPP
+#define CORO_ASYNC_ACCEPT_DISTRIBUTOR_HPP
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include "coro-async/io_service.hpp"
+#include "coro-async/tcp_acceptor.hpp"
+#include "coro-async/detail/operation_base.hpp"
+
+namespace coro_async {
+
+/**
+ * Accepts connections on one or a few `tcp_acceptor`s and
+ * hands every new descriptor to one of a set of shards, where
+ * a shard is an `io_service` run by a single thread.
+ *
+ * Unlike SO_REUSEPORT hashing, the shard is picked by its load:
+ * - `least_connections`: the fewest active connections.
+ * - `least_utilization`: the lowest loop utilization over the
+ *   last `sample_interval`; among the shards within
+ *   `utilization_slack` of it, the fewest active connections,
+ *   so that a burst does not pile up on one shard in between
+ *   two samples.
+ * - `incoming_cpu`: shard `cpu % size()` where `cpu` received
+ *   the connection (SO_INCOMING_CPU). Assumes shard `i` runs on
+ *   CPU `i`. Falls back to `least_connections` if unavailable.
+ *
+ * The handler runs on the chosen shard and owns the descriptor.
+ * When that shard is the one running the accept, the handler is
+ * called inline from the accept loop, without a queue hop.
+ * A connection counts as active from the moment it is dispatched
+ * till `connection_closed` is called for it.
+ *
+ * NOTE: The acceptors must be open, bound and listening, and
+ * each of them is driven by its own io_service. The distributor
+ * must outlive the io_services of the acceptors and the shards.
+ */
+class accept_distributor
+{
+public:
+  /// How the shard for a connection is picked
+  enum class policy
+  {
+    least_connections,
+    least_utilization,
+    incoming_cpu,
+  };
+
+  /// Tuning
+  struct options
+  {
+    /// How the shard is picked
+    policy balance = policy::least_connections;
+    /// How often the shard utilization is sampled
+    std::chrono::milliseconds sample_interval{100};
+    /// Utilization difference (0..1) treated as equal
+    double utilization_slack = 0.05;
+    /// Connections accepted per readiness event
+    size_t max_accepts_per_event = 16;
+  };
+
+  /**
+   * Connection handler. Called on the chosen shard with
+   * the shard id and the connected descriptor.
+   */
+  using handler_type = std::function<void(size_t shard, int fd)>;
+
+public:
+  ///
+  accept_distributor(std::vector<tcp_acceptor*> acceptors,
+                     std::vector<io_service*> shards)
+    : accept_distributor(std::move(acceptors), std::move(shards), options{})
+  {
+  }
+
+  ///
+  accept_distributor(std::vector<tcp_acceptor*> acceptors,
+                     std::vector<io_service*> shards,
+                     options opts);
+
+  /// The connections are handed to the shards from the accepting thread.
+  template <typename Threading, typename... Opts, bool = detail::assert_concurrent<Threading>()>
+  accept_distributor(std::vector<tcp_acceptor*>,
+                     std::vector<basic_io_service<Threading>*>,
+                     Opts&&...) = delete;
+
+  accept_distributor(const accept_distributor&) = delete;
+  accept_distributor& operator=(const accept_distributor&) = delete;
+
+  ~accept_distributor() = default;
+
+public:
+  /// Start accepting on all the acceptors.
+  void start(handler_type handler);
+
+  /**
+   * A connection dispatched to `shard` is gone.
+   * Thread safe.
+   */
+  void connection_closed(size_t shard) noexcept
+  {
+    shards_[shard]->active_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  /// Number of shards
+  size_t size() const noexcept
+  {
+    return shards_.size();
+  }
+
+  ///
+  io_service& shard(size_t id) noexcept
+  {
+    return *shards_[id]->ios_;
+  }
+
+  /// Active connections on `shard`. Thread safe.
+  size_t active_connections(size_t shard) const noexcept
+  {
+    return shards_[shard]->active_.load(std::memory_order_relaxed);
+  }
+
+  /// Utilization (0..1) of `shard` as last sampled. Thread safe.
+  double utilization(size_t shard) const noexcept
+  {
+    return shards_[shard]->utilization_.load(std::memory_order_relaxed) / 1000.0;
+  }
+
+  /**
+   * The error which stopped the accept loop of `acceptor`,
+   * if any. Only to be read once its io_service is stopped.
+   */
+  const std::error_code& accept_error(size_t acceptor) const noexcept
+  {
+    return accepts_[acceptor]->ec_;
+  }
+
+private:
+  using clock_type = std::chrono::steady_clock;
+
+  /// The load of a shard
+  struct alignas(64) shard_load
+  {
+    ///
+    io_service* ios_ = nullptr;
+    /// Dispatched and not yet closed
+    std::atomic<size_t> active_{0};
+    /// Utilization in per mille
+    std::atomic<uint32_t> utilization_{0};
+    /// Idle time at the last sample (sampler only)
+    std::chrono::nanoseconds last_idle_{0};
+  };
+
+  /// The accept loop of one acceptor. Re-armed after every batch.
+  struct accept_loop: detail::operation_base
+  {
+    accept_loop(accept_distributor& owner, tcp_acceptor& acc)
+      : detail::operation_base(accept_loop::complete)
+      , owner_(owner)
+      , acceptor_(acc)
+    {
+    }
+
+    /// Called when the acceptor is readable.
+    static void complete(detail::operation_base* op,
+                         const std::error_code& ec,
+                         size_t bytes_xferred);
+
+    ///
+    accept_distributor& owner_;
+    ///
+    tcp_acceptor& acceptor_;
+    /// The error which stopped the loop
+    std::error_code ec_;
+  };
+
+  /// Accept what is pending on `loop` and re-arm it.
+  void on_readable(accept_loop& loop);
+
+  /// Pick the shard for `fd` and account it.
+  size_t pick_shard(int fd);
+
+  /// Fewest active connections among the shards within `max_util`.
+  size_t least_connections(uint32_t max_util) const noexcept;
+
+  /// Refresh the utilization if `sample_interval` has passed.
+  void maybe_sample();
+
+  /// Run the handler for `fd` on `shard`. Inline if on that shard.
+  void dispatch(size_t shard, int fd);
+
+private:
+  /// Tuning
+  options opts_;
+
+  /// The shards
+  std::vector<std::unique_ptr<shard_load>> shards_;
+
+  /// One loop per acceptor
+  std::vector<std::unique_ptr<accept_loop>> accepts_;
+
+  /// The connection handler
+  handler_type handler_;
+
+  /// Round robin start of the shard scan, breaks ties
+  mutable std::atomic<size_t> next_{0};
+
+  /// Serializes sampling across the acceptor threads
+  std::mutex sample_lock_;
+
+  /// When the utilization was last sampled
+  clock_type::time_point last_sample_;
+};
+
+} // END namespace coro_async
+
+#include "coro-async/impl/accept_distributor.ipp"
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef CORO_ASYNC_ASYNC_FILE_HPP
+#define CORO_ASYNC_ASYNC_FILE_HPP
+
+#include <string>
+#include <system_error>
+#include <sys/types.h>
+
+#include "coro-async/io_service.hpp"
+#include "coro-async/buffer_ref.hpp"
+#include "coro-async/thread_pool.hpp"
+
+namespace coro_async {
+
+/**
+ * A regular file with asynchronous operations.
+ *
+ * epoll cannot wait on regular files, so every blocking
+ * call (open, pread, pwrite, fsync) is run on a `thread_pool`
+ * and its completion handler is posted back to the
+ * io_service. The io_service thread never touches the disk.
+ *
+ * The handler signature for all operations is:
+ *   void(const std::error_code&, size_t bytes_xferred)
+ *
+ * NOTE: The file object and the buffers must outlive the
+ * pending operations.
+ */
+class async_file
+{
+public:
+  ///
+  async_file(io_service& ios, thread_pool& pool)
+    : ios_(ios)
+    , pool_(pool)
+  {
+  }
+
+  /// The completions are posted from the pool threads.
+  template <typename Threading, bool = detail::assert_concurrent<Threading>()>
+  async_file(basic_io_service<Threading>&, thread_pool&) = delete;
+
+  /// Move constructible
+  async_file(async_file&& other) noexcept
+    : ios_(other.ios_)
+    , pool_(other.pool_)
+    , fd_(other.fd_)
+  {
+    other.fd_ = -1;
+  }
+
+  async_file(const async_file&) = delete;
+  async_file& operator=(const async_file&) = delete;
+
+  ///
+  ~async_file()
+  {
+    close();
+  }
+
+public:
+  ///
+  bool is_open() const noexcept
+  {
+    return fd_ != -1;
+  }
+
+  /// Get the native file descriptor
+  int get_native_handle() const noexcept
+  {
+    return fd_;
+  }
+
+  ///
+  io_service& get_io_service() noexcept
+  {
+    return ios_;
+  }
+
+  /// Close the file.
+  void close() noexcept;
+
+public: // Async Operations
+  /**
+   * Open the file at `path` with the `open(2)` flags and mode.
+   * The file is open once the handler gets called without error.
+   */
+  template <typename Handler>
+  void async_open(std::string path, int flags, mode_t mode, Handler&& h);
+
+  /**
+   * Read atmost `buf.size()` bytes at `offset`.
+   * Reports 0 bytes at end of file.
+   */
+  template <typename Handler>
+  void async_pread(buffer::buffer_ref buf, off_t offset, Handler&& h);
+
+  /// Write all of `buf` at `offset`.
+  template <typename Handler>
+  void async_pwrite(buffer::buffer_ref buf, off_t offset, Handler&& h);
+
+  /// Flush data and metadata to disk.
+  template <typename Handler>
+  void async_fsync(Handler&& h);
+
+  /// Flush data (and only the metadata needed to read it back) to disk.
+  template <typename Handler>
+  void async_fdatasync(Handler&& h);
+
+private:
+  /**
+   * Run `fn` on the pool and post `h` with its result
+   * back to the io_service.
+   * `fn` signature: size_t(std::error_code&)
+   */
+  template <typename Fn, typename Handler>
+  void run_blocking(Fn&& fn, Handler&& h);
+
+private:
+  /// The io_service on which handlers are run
+  io_service& ios_;
+
+  /// The pool on which the blocking calls are made
+  thread_pool& pool_;
+
+  /// The file descriptor
+  int fd_ = -1;
+};
+
+} // END namespace coro_async
+
+#include "coro-async/impl/async_file.ipp"
+
+#endif
@@ -26,6 +26,7 @@
 #include <experimental/coroutine>
 
 #include "coro-async/tcp_acceptor.hpp"
+#include "coro-async/local_acceptor.hpp"
 #include "coro-async/stream_socket.hpp"
 #include "coro-async/coro/coro_socket.hpp"
 
@@ -33,23 +34,25 @@ namespace coro_async {
 
 /**
  * An awaitable for performing socket accept call.
+ * `Acceptor` is either `tcp_acceptor` or `local_acceptor`.
  */
-class accept_awaitable
+template <typename Acceptor>
+class basic_accept_awaitable
 {
 public:
   ///
-  accept_awaitable(io_service& ios, tcp_acceptor& acceptor)
+  basic_accept_awaitable(io_executor& ios, Acceptor& acceptor)
     : acceptor_(acceptor)
     , client_sock_(ios)
   {
   }
 
   ///
-  accept_awaitable(const accept_awaitable&) = delete;
+  basic_accept_awaitable(const basic_accept_awaitable&) = delete;
   ///
-  accept_awaitable& operator=(const accept_awaitable&) = delete;
+  basic_accept_awaitable& operator=(const basic_accept_awaitable&) = delete;
   ///
-  ~accept_awaitable()
+  ~basic_accept_awaitable()
   {
   }
 
@@ -98,7 +101,7 @@ private:
 
 private:
   /// The acceptor
-  tcp_acceptor& acceptor_;
+  Acceptor& acceptor_;
 
   /// The underlying streaming socket reference
   coro_socket client_sock_;
@@ -107,6 +110,12 @@ private:
   std::error_code acc_ec_;
 };
 
+/// Awaitable for accepting TCP connections
+using accept_awaitable = basic_accept_awaitable<tcp_acceptor>;
+
+/// Awaitable for accepting unix domain connections
+using local_accept_awaitable = basic_accept_awaitable<local_acceptor>;
+
 } // END namespace coro_async
 
 #endif
@@ -3,28 +3,32 @@
 
 #include <experimental/coroutine>
 #include "coro-async/endpoint.hpp"
+#include "coro-async/local_endpoint.hpp"
 #include "coro-async/coro/coro_socket.hpp"
 
 namespace coro_async {
 
 /**
+ * An awaitable for connecting a new socket to the peer.
+ * `Endpoint` is either `endpoint` or `local_endpoint`.
  */
-class connect_awaitable
+template <typename Endpoint>
+class basic_connect_awaitable
 {
 public:
   ///
-  connect_awaitable(io_service& ios, endpoint ep)
+  basic_connect_awaitable(io_executor& ios, Endpoint ep)
     : client_sock_(ios)
     , peer_(std::move(ep))
   {
   }
 
   ///
-  connect_awaitable(const connect_awaitable&) = delete;
+  basic_connect_awaitable(const basic_connect_awaitable&) = delete;
   ///
-  connect_awaitable& operator=(const connect_awaitable&) = delete;
+  basic_connect_awaitable& operator=(const basic_connect_awaitable&) = delete;
   ///
-  ~connect_awaitable() = default;
+  ~basic_connect_awaitable() = default;
 
 public: // Awaitable implementation
   ///
@@ -69,12 +73,18 @@ private:
   coro_socket client_sock_;
 
   /// The enpoint to connect to
-  endpoint peer_;
+  Endpoint peer_;
 
   /// Error code for async connect
   std::error_code conn_ec_;
 };
 
+/// Awaitable for TCP connect
+using connect_awaitable = basic_connect_awaitable<endpoint>;
+
+/// Awaitable for unix domain socket connect
+using local_connect_awaitable = basic_connect_awaitable<local_endpoint>;
+
 } // END namespace coro_async
 
 #endif
@@ -0,0 +1,406 @@
+#ifndef CORO_ASYNC_CONNECTION_POOL_HPP
+#define CORO_ASYNC_CONNECTION_POOL_HPP
+
+#include <deque>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <experimental/coroutine>
+
+#include "coro-async/endpoint.hpp"
+#include "coro-async/io_service.hpp"
+#include "coro-async/coro/result.hpp"
+#include "coro-async/coro/coro_socket.hpp"
+#include "coro-async/detail/socket_ops.hpp"
+
+namespace stdex = std::experimental;
+
+namespace coro_async {
+
+class connection_pool;
+
+/**
+ * An awaitable for acquiring a connected socket from
+ * a `connection_pool`.
+ * Completes without suspending if an idle connection is
+ * available. Otherwise it either connects a new socket or
+ * waits for a connection to be released back to the pool.
+ */
+class pool_connect_awaitable
+{
+public:
+  ///
+  pool_connect_awaitable(connection_pool& pool, endpoint ep)
+    : pool_(pool)
+    , peer_(std::move(ep))
+  {
+  }
+
+  /// An awaitable which completes right away with `ec`.
+  pool_connect_awaitable(connection_pool& pool, std::error_code ec)
+    : pool_(pool)
+    , conn_ec_(ec)
+  {
+  }
+
+  ///
+  pool_connect_awaitable(const pool_connect_awaitable&) = delete;
+  ///
+  pool_connect_awaitable& operator=(const pool_connect_awaitable&) = delete;
+  ///
+  ~pool_connect_awaitable() = default;
+
+public: // Awaitable implementation
+  /// Ready if an idle connection could be reused (or on error).
+  bool await_ready();
+
+  /// Connects a new socket or queues up behind other waiters.
+  template <typename PromiseType>
+  void await_suspend(stdex::coroutine_handle<PromiseType> ch)
+  {
+    ch_ = ch;
+    wait_for_connection();
+  }
+
+  /**
+   * Returns the connected socket wrapped inside
+   * `result_type_non_coro`. In case of error, the wrapped
+   * value is the error_code.
+   */
+  result_type_non_coro<coro_socket> await_resume() noexcept
+  {
+    if (conn_ec_)
+    {
+      return { conn_ec_ };
+    }
+    return { std::move(*client_sock_) };
+  }
+
+private:
+  friend class connection_pool;
+
+  ///
+  void wait_for_connection();
+
+  /// Start connecting a fresh socket to the peer.
+  void start_connect();
+
+  /// Called once the fresh socket connect finishes.
+  void handle_connection_complete(const std::error_code& ec);
+
+private:
+  /// The pool this awaitable acquires from
+  connection_pool& pool_;
+
+  /// The endpoint to connect to
+  endpoint peer_;
+
+  /// The acquired (or connecting) socket
+  std::optional<coro_socket> client_sock_;
+
+  /// The suspended coroutine
+  stdex::coroutine_handle<> ch_ = nullptr;
+
+  /// Error code for async connect
+  std::error_code conn_ec_;
+};
+
+
+/**
+ * A per `io_service` pool of connected client sockets
+ * keyed by the peer endpoint.
+ *
+ * - At most `max_per_endpoint` connections (idle + in use)
+ *   are kept open for an endpoint.
+ * - Once the limit is hit, `connect` waits for a connection
+ *   to be `release`d or `discard`ed.
+ * - Idle connections are closed after `idle_timeout`.
+ *
+ * Every connection handed out by the pool *must* be given back
+ * with `release` (still usable) or `discard` (broken / closed),
+ * else its slot is never freed.
+ *
+ * NOTE: Not thread safe. To be used only from the thread
+ * running the io_service.
+ */
+class connection_pool
+{
+public:
+  /// The clock used for tracking idle time
+  using clock_type = std::chrono::steady_clock;
+
+public:
+  ///
+  connection_pool(io_executor& ios,
+                  size_t max_per_endpoint = 8,
+                  std::chrono::milliseconds idle_timeout = std::chrono::seconds(30))
+    : ios_(ios)
+    , max_per_endpoint_(max_per_endpoint)
+    , idle_timeout_(idle_timeout)
+  {
+    assert (max_per_endpoint_ > 0);
+  }
+
+  ///
+  connection_pool(const connection_pool&) = delete;
+  connection_pool& operator=(const connection_pool&) = delete;
+
+  ~connection_pool() = default;
+
+public:
+  /// Get a connected socket to `ep`.
+  pool_connect_awaitable connect(endpoint ep)
+  {
+    return { *this, std::move(ep) };
+  }
+
+  /**
+   * Get a connected socket to `ip`:`port`.
+   * An invalid `ip` fails the connect with EINVAL.
+   */
+  pool_connect_awaitable connect(const char* ip, uint16_t port)
+  {
+    ip_address addr;
+    if (!ip_address::from_string(ip, addr))
+    {
+      return { *this, std::error_code{EINVAL, error::theAddressErrorCat} };
+    }
+    return { *this, endpoint{addr, port} };
+  }
+
+  /**
+   * Give back a usable connection to the pool.
+   * It is directly handed over to a waiter if there is one.
+   */
+  void release(const endpoint& ep, coro_socket&& sock)
+  {
+    auto& entry = pools_[ep];
+    assert (entry.live_ > 0);
+
+    if (!entry.waiters_.empty())
+    {
+      auto w = entry.waiters_.front();
+      entry.waiters_.pop_front();
+      w->client_sock_.emplace(std::move(sock));
+      ios_.post([w]() { w->ch_.resume(); });
+      return;
+    }
+
+    entry.idle_.push_back({ std::move(sock), clock_type::now() });
+    arm_idle_timer();
+  }
+
+  /**
+   * Tell the pool that a connection it handed out is not
+   * reusable any more. The socket itself is closed by its owner.
+   */
+  void discard(const endpoint& ep)
+  {
+    auto& entry = pools_[ep];
+    assert (entry.live_ > 0);
+    entry.live_--;
+    connect_next_waiter(entry);
+  }
+
+  /// Number of idle connections to `ep`.
+  size_t idle_connections(const endpoint& ep) const noexcept
+  {
+    auto it = pools_.find(ep);
+    return it == pools_.end() ? 0 : it->second.idle_.size();
+  }
+
+  /// Number of open connections (idle + in use) to `ep`.
+  size_t live_connections(const endpoint& ep) const noexcept
+  {
+    auto it = pools_.find(ep);
+    return it == pools_.end() ? 0 : it->second.live_;
+  }
+
+  ///
+  io_executor& get_io_service() noexcept
+  {
+    return ios_;
+  }
+
+private:
+  friend class pool_connect_awaitable;
+
+  /// An idle connection along with when it became idle
+  struct idle_connection
+  {
+    coro_socket sock_;
+    clock_type::time_point since_;
+  };
+
+  /// Book keeping per endpoint
+  struct endpoint_pool
+  {
+    /// Idle connections. Most recently used at the back.
+    std::deque<idle_connection> idle_;
+    /// Awaitables waiting for a free slot
+    std::deque<pool_connect_awaitable*> waiters_;
+    /// Number of open connections (idle + in use)
+    size_t live_ = 0;
+  };
+
+  /**
+   * Pop the most recently used healthy idle connection.
+   * Connections closed by the peer while idle are dropped.
+   */
+  bool take_idle(const endpoint& ep, std::optional<coro_socket>& out)
+  {
+    auto it = pools_.find(ep);
+    if (it == pools_.end()) return false;
+
+    auto& entry = it->second;
+    while (!entry.idle_.empty())
+    {
+      auto& conn = entry.idle_.back();
+      if (detail::posix_socket_ops::is_reusable(
+            conn.sock_.get_stream_sock().get_native_handle()))
+      {
+        out.emplace(std::move(conn.sock_));
+        entry.idle_.pop_back();
+        return true;
+      }
+      entry.idle_.pop_back();
+      entry.live_--;
+    }
+    return false;
+  }
+
+  /// Connect if under the limit, else wait in queue.
+  void acquire_or_wait(pool_connect_awaitable* w)
+  {
+    auto& entry = pools_[w->peer_];
+    if (entry.live_ < max_per_endpoint_)
+    {
+      entry.live_++;
+      w->start_connect();
+      return;
+    }
+    entry.waiters_.push_back(w);
+  }
+
+  /// A slot got freed up. Let the first waiter connect.
+  void connect_next_waiter(endpoint_pool& entry)
+  {
+    if (entry.waiters_.empty() || entry.live_ >= max_per_endpoint_) return;
+
+    auto w = entry.waiters_.front();
+    entry.waiters_.pop_front();
+    entry.live_++;
+    w->start_connect();
+  }
+
+  /// The fresh connection attempt for `w` failed.
+  void connect_failed(pool_connect_awaitable* w)
+  {
+    discard(w->peer_);
+  }
+
+  /// Schedule the idle connection sweep if not done already.
+  void arm_idle_timer()
+  {
+    if (timer_armed_) return;
+    timer_armed_ = true;
+
+    std::weak_ptr<bool> alive = alive_;
+    ios_.schedule_after(idle_timeout_, [this, alive]() {
+          if (alive.expired()) return;
+          this->evict_idle();
+        });
+  }
+
+  /// Close connections which have been idle for too long.
+  void evict_idle()
+  {
+    timer_armed_ = false;
+    const auto now = clock_type::now();
+    bool have_idle = false;
+
+    for (auto& kv : pools_)
+    {
+      auto& entry = kv.second;
+      while (!entry.idle_.empty() &&
+             now - entry.idle_.front().since_ >= idle_timeout_)
+      {
+        entry.idle_.pop_front();
+        entry.live_--;
+      }
+      have_idle = have_idle || !entry.idle_.empty();
+    }
+
+    if (have_idle) arm_idle_timer();
+  }
+
+private:
+  /// The io_service instance
+  io_executor& ios_;
+
+  /// Max open connections per endpoint
+  size_t max_per_endpoint_ = 0;
+
+  /// Time after which an idle connection is closed
+  std::chrono::milliseconds idle_timeout_;
+
+  /// Per endpoint pool
+  std::unordered_map<endpoint, endpoint_pool> pools_;
+
+  /// Is the idle sweep timer scheduled
+  bool timer_armed_ = false;
+
+  /// Guards the timer callback against pool destruction
+  std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
+};
+
+//================================================================================
+
+inline bool pool_connect_awaitable::await_ready()
+{
+  if (conn_ec_) return true;
+  return pool_.take_idle(peer_, client_sock_);
+}
+
+inline void pool_connect_awaitable::wait_for_connection()
+{
+  pool_.acquire_or_wait(this);
+}
+
+inline void pool_connect_awaitable::start_connect()
+{
+  client_sock_.emplace(pool_.get_io_service());
+  auto& sock = client_sock_->get_stream_sock();
+
+  std::error_code ec{};
+  if (!sock.open(peer_.family(), ec))
+  {
+    pool_.get_io_service().post([this, ec]() {
+          this->handle_connection_complete(ec);
+        });
+    return;
+  }
+
+  sock.async_connect(peer_,
+        [this](const std::error_code ec, size_t bytes_xferred)
+        {
+          (void)bytes_xferred;
+          this->handle_connection_complete(ec);
+        });
+}
+
+inline void pool_connect_awaitable::handle_connection_complete(const std::error_code& ec)
+{
+  if (ec)
+  {
+    conn_ec_ = ec;
+    client_sock_.reset();
+    pool_.connect_failed(this);
+  }
+  ch_.resume();
+}
+
+} // END namespace coro_async
+
+#endif
@@ -39,7 +39,7 @@ class coro_acceptor
 {
 public:
   ///
-  coro_acceptor(io_service& ios)
+  coro_acceptor(io_executor& ios)
     : ios_(ios)
     , acceptor_(ios)
   {
@@ -51,14 +51,14 @@ public:
   {
     ec.clear();
 
-    acceptor_.open(ec);
+    endpoint ep{ip_address{ip}, port};
+
+    acceptor_.open(ep.family(), ec);
     if (ec)
     {
       return;
     }
 
-    endpoint ep{v4_address{ip}, port};
-
     acceptor_.bind(ep, ec);
     if (ec)
     {
@@ -72,6 +72,39 @@ public:
     }
   }
 
+  /**
+   * Listen on `port` on all interfaces for both IPv6
+   * and IPv4 clients with a single IPv6 socket.
+   */
+  void open_dual_stack(uint16_t port, std::error_code& ec, uint32_t backlog=10)
+  {
+    ec.clear();
+
+    acceptor_.open(AF_INET6, ec);
+    if (ec)
+    {
+      return;
+    }
+
+    acceptor_.set_v6_only(false, ec);
+    if (ec)
+    {
+      return;
+    }
+
+    acceptor_.bind(endpoint{v6_address::any(), port}, ec);
+    if (ec)
+    {
+      return;
+    }
+
+    acceptor_.listen(backlog, ec);
+    if (ec)
+    {
+      return;
+    }
+  }
+
   ///
   // TODO: check for error
   accept_awaitable accept()
@@ -80,7 +113,7 @@ public:
   }
 
   ///
-  io_service& get_io_service() noexcept
+  io_executor& get_io_service() noexcept
   {
     return ios_;
   }
@@ -93,7 +126,7 @@ public:
 
 private:
   /// The io_service instance
-  io_service& ios_;
+  io_executor& ios_;
 
   /// The acceptor instance
   tcp_acceptor acceptor_;
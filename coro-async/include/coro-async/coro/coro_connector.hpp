@@ -2,6 +2,7 @@
 #define CORO_ASYNC_CORO_CONNECTOR_HPP
 
 #include "coro-async/endpoint.hpp"
+#include "coro-async/local_endpoint.hpp"
 #include "coro-async/io_service.hpp"
 #include "coro-async/coro/connect_awaitable.hpp"
 
@@ -13,7 +14,7 @@ class coro_connector
 {
 public:
   ///
-  coro_connector(io_service& ios)
+  coro_connector(io_executor& ios)
     : ios_(ios)
   {
   }
@@ -23,19 +24,31 @@ public:
   // TODO: check for error
   connect_awaitable connect(const char* ip, uint16_t port)
   {
-    endpoint ep{v4_address{ip}, port};
+    endpoint ep{ip_address{ip}, port};
     return { ios_, ep };
   }
 
   ///
-  io_service& get_io_service() noexcept
+  connect_awaitable connect(endpoint ep)
+  {
+    return { ios_, std::move(ep) };
+  }
+
+  /// Connect to the unix domain socket at `ep`.
+  local_connect_awaitable connect(local_endpoint ep)
+  {
+    return { ios_, std::move(ep) };
+  }
+
+  ///
+  io_executor& get_io_service() noexcept
   {
     return ios_;
   }
 
 private:
   /// The io_service instance
-  io_service& ios_;
+  io_executor& ios_;
 };
 
 } // END namespace coro_async
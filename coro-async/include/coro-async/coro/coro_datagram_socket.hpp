@@ -0,0 +1,86 @@
+#ifndef CORO_ASYNC_CORO_DATAGRAM_SOCKET_HPP
+#define CORO_ASYNC_CORO_DATAGRAM_SOCKET_HPP
+
+#include "coro-async/endpoint.hpp"
+#include "coro-async/io_service.hpp"
+#include "coro-async/datagram_batch.hpp"
+#include "coro-async/datagram_socket.hpp"
+#include "coro-async/coro/datagram_awaitable.hpp"
+
+namespace coro_async {
+
+/**
+ * A thin wrapper over `datagram_socket` for providing
+ * an awaitable based interface for batched send / receive.
+ */
+class coro_datagram_socket
+{
+public:
+  ///
+  coro_datagram_socket(io_executor& ios)
+    : ios_(ios)
+    , sock_(ios)
+  {
+  }
+
+  coro_datagram_socket(coro_datagram_socket&& other) = default;
+
+  ~coro_datagram_socket() = default;
+
+public:
+  /// Open and bind to (ip:port)
+  void open(const char* ip, uint16_t port, std::error_code& ec)
+  {
+    ec.clear();
+
+    ip_address addr{};
+    if (!ip_address::from_string(ip, addr))
+    {
+      ec = std::error_code{EINVAL, std::system_category()};
+      return;
+    }
+    sock_.bind(endpoint{addr, port}, ec);
+  }
+
+  ///
+  datagram_socket& get_datagram_sock() noexcept
+  {
+    return sock_;
+  }
+
+  ///
+  io_executor& get_io_service() noexcept
+  {
+    return ios_;
+  }
+
+  ///
+  void close()
+  {
+    sock_.close();
+  }
+
+public: // The awaitables
+  /// Receive upto `batch.capacity()` datagrams
+  auto receive_batch(datagram_batch& batch)
+  {
+    return receive_batch_awaitable{sock_, batch};
+  }
+
+  /// Send all the datagrams in `batch`
+  auto send_batch(datagram_batch& batch)
+  {
+    return send_batch_awaitable{sock_, batch};
+  }
+
+private:
+  /// The io_service
+  io_executor& ios_;
+
+  /// The underlying datagram socket
+  datagram_socket sock_;
+};
+
+} // END namespace coro_async
+
+#endif
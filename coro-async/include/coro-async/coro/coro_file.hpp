@@ -0,0 +1,170 @@
+#ifndef CORO_ASYNC_CORO_FILE_HPP
+#define CORO_ASYNC_CORO_FILE_HPP
+
+#include <string>
+#include <experimental/coroutine>
+
+#include "coro-async/async_file.hpp"
+#include "coro-async/buffer_ref.hpp"
+#include "coro-async/io_service.hpp"
+#include "coro-async/thread_pool.hpp"
+#include "coro-async/coro/result.hpp"
+
+namespace stdex = std::experimental;
+
+namespace coro_async {
+
+/**
+ * An awaitable for any `async_file` operation.
+ * `Initiator` starts the operation given the completion
+ * handler. The coroutine is resumed on the io_service thread.
+ */
+template <typename Initiator>
+class file_awaitable
+{
+public:
+  ///
+  file_awaitable(Initiator init)
+    : init_(std::move(init))
+  {
+  }
+
+  ///
+  file_awaitable(const file_awaitable&) = delete;
+  ///
+  file_awaitable& operator=(const file_awaitable&) = delete;
+  ///
+  ~file_awaitable() = default;
+
+public: // Awaitable implementation
+  ///
+  bool await_ready()
+  {
+    return false;
+  }
+
+  /// Starts the operation on the blocking I/O pool.
+  template <typename PromiseType>
+  void await_suspend(stdex::coroutine_handle<PromiseType> ch)
+  {
+    init_([this, ch](const std::error_code& ec, size_t bytes_xferred) {
+            ec_ = ec;
+            bytes_xferred_ = bytes_xferred;
+            ch.resume();
+          });
+  }
+
+  /**
+   * Returns the bytes transferred (0 for open / fsync)
+   * wrapped inside `result_type_non_coro`.
+   * In case of error, the wrapped value is the error_code.
+   */
+  result_type_non_coro<size_t> await_resume()
+  {
+    if (ec_) return { ec_ };
+    else     return { bytes_xferred_ };
+  }
+
+private:
+  /// Starts the operation
+  Initiator init_;
+
+  /// Bytes transferred
+  size_t bytes_xferred_ = 0;
+
+  /// The error in async operation
+  std::error_code ec_;
+};
+
+
+/**
+ * A thin wrapper over `async_file` for providing an
+ * awaitable based interface.
+ */
+class coro_file
+{
+public:
+  ///
+  coro_file(io_service& ios, thread_pool& pool)
+    : file_(ios, pool)
+  {
+  }
+
+  /// The completions are posted from the pool threads.
+  template <typename Threading, bool = detail::assert_concurrent<Threading>()>
+  coro_file(basic_io_service<Threading>&, thread_pool&) = delete;
+
+  coro_file(coro_file&& other) = default;
+
+  ~coro_file() = default;
+
+public:
+  ///
+  async_file& get_file() noexcept
+  {
+    return file_;
+  }
+
+  ///
+  void close() noexcept
+  {
+    file_.close();
+  }
+
+public: // The awaitables
+  /// Open the file at `path`
+  auto open(std::string path, int flags, mode_t mode = 0644)
+  {
+    return make_awaitable([this, path{std::move(path)}, flags, mode](auto&& h) mutable {
+             file_.async_open(std::move(path), flags, mode, std::move(h));
+           });
+  }
+
+  /// Read atmost `buf.size()` bytes at `offset`
+  auto pread(buffer::buffer_ref buf, off_t offset)
+  {
+    return make_awaitable([this, buf, offset](auto&& h) {
+             file_.async_pread(buf, offset, std::move(h));
+           });
+  }
+
+  /// Write all of `buf` at `offset`
+  auto pwrite(buffer::buffer_ref buf, off_t offset)
+  {
+    return make_awaitable([this, buf, offset](auto&& h) {
+             file_.async_pwrite(buf, offset, std::move(h));
+           });
+  }
+
+  ///
+  auto fsync()
+  {
+    return make_awaitable([this](auto&& h) {
+             file_.async_fsync(std::move(h));
+           });
+  }
+
+  ///
+  auto fdatasync()
+  {
+    return make_awaitable([this](auto&& h) {
+             file_.async_fdatasync(std::move(h));
+           });
+  }
+
+private:
+  ///
+  template <typename Initiator>
+  static file_awaitable<Initiator> make_awaitable(Initiator init)
+  {
+    return { std::move(init) };
+  }
+
+private:
+  /// The underlying file
+  async_file file_;
+};
+
+} // END namespace coro_async
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef CORO_ASYNC_CORO_LOCAL_ACCEPTOR_HPP
+#define CORO_ASYNC_CORO_LOCAL_ACCEPTOR_HPP
+
+#include <string_view>
+#include <unistd.h>
+
+#include "coro-async/io_service.hpp"
+#include "coro-async/local_endpoint.hpp"
+#include "coro-async/local_acceptor.hpp"
+#include "coro-async/coro/accept_awaitable.hpp"
+
+namespace coro_async {
+
+/**
+ * A thin wrapper over `local_acceptor` to return an
+ * awaitable object for accepting unix domain connections.
+ */
+class coro_local_acceptor
+{
+public:
+  ///
+  coro_local_acceptor(io_executor& ios)
+    : ios_(ios)
+    , acceptor_(ios)
+  {
+  }
+
+public:
+  /**
+   * Listen on the unix socket at `path`.
+   * A leftover socket file at `path` (from a previous run)
+   * is removed first. Abstract paths (starting with '\0')
+   * have no file to remove.
+   */
+  void open(std::string_view path, std::error_code& ec, uint32_t backlog=10)
+  {
+    ec.clear();
+
+    local_endpoint ep{path};
+    if (!ep.is_abstract())
+    {
+      ::unlink(ep.path().c_str());
+    }
+
+    acceptor_.open(ec);
+    if (ec)
+    {
+      return;
+    }
+
+    acceptor_.bind(ep, ec);
+    if (ec)
+    {
+      return;
+    }
+
+    acceptor_.listen(backlog, ec);
+    if (ec)
+    {
+      return;
+    }
+  }
+
+  ///
+  local_accept_awaitable accept()
+  {
+    return { ios_, acceptor_ };
+  }
+
+  ///
+  io_executor& get_io_service() noexcept
+  {
+    return ios_;
+  }
+
+  ///
+  local_acceptor& get_underlying_acceptor() noexcept
+  {
+    return acceptor_;
+  }
+
+private:
+  /// The io_service instance
+  io_executor& ios_;
+
+  /// The acceptor instance
+  local_acceptor acceptor_;
+};
+
+} // END namespace coro_async
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef CORO_ASYNC_CORO_RESOLVER_HPP
+#define CORO_ASYNC_CORO_RESOLVER_HPP
+
+#include <string>
+#include <experimental/coroutine>
+
+#include "coro-async/resolver.hpp"
+#include "coro-async/io_service.hpp"
+#include "coro-async/coro/result.hpp"
+
+namespace stdex = std::experimental;
+
+namespace coro_async {
+
+/**
+ * An awaitable for resolving a host name.
+ * Completes without suspending when the answer is
+ * available from memory.
+ */
+class resolve_awaitable
+{
+public:
+  ///
+  resolve_awaitable(resolver& r, std::string host, uint16_t port)
+    : resolver_(r)
+    , host_(std::move(host))
+    , port_(port)
+  {
+  }
+
+  ///
+  resolve_awaitable(const resolve_awaitable&) = delete;
+  ///
+  resolve_awaitable& operator=(const resolve_awaitable&) = delete;
+  ///
+  ~resolve_awaitable() = default;
+
+public: // Awaitable implementation
+  ///
+  bool await_ready()
+  {
+    return resolver_.try_resolve(host_, port_, results_, ec_);
+  }
+
+  ///
+  template <typename PromiseType>
+  void await_suspend(stdex::coroutine_handle<PromiseType> ch)
+  {
+    resolver_.async_resolve(host_, port_,
+          [this, ch](const std::error_code& ec, resolver::results_type res) mutable
+          {
+            ec_ = ec;
+            results_ = std::move(res);
+            ch.resume();
+          });
+  }
+
+  /**
+   * Returns the resolved endpoints wrapped inside
+   * `result_type_non_coro`. In case of error, the wrapped
+   * value is the error_code.
+   */
+  result_type_non_coro<resolver::results_type> await_resume() noexcept
+  {
+    if (ec_)
+    {
+      return { ec_ };
+    }
+    return { std::move(results_) };
+  }
+
+private:
+  /// The resolver
+  resolver& resolver_;
+
+  /// The host to resolve
+  std::string host_;
+
+  /// The port of the resolved endpoints
+  uint16_t port_ = 0;
+
+  /// The resolved endpoints
+  resolver::results_type results_;
+
+  /// Error in resolution
+  std::error_code ec_;
+};
+
+
+/**
+ * A thin wrapper over `resolver` to return an
+ * awaitable object for resolving host names.
+ */
+class coro_resolver
+{
+public:
+  ///
+  coro_resolver(io_service& ios)
+    : ios_(ios)
+    , resolver_(ios)
+  {
+  }
+
+  ///
+  coro_resolver(io_service& ios, resolver::options opts)
+    : ios_(ios)
+    , resolver_(ios, std::move(opts))
+  {
+  }
+
+  /// The queries complete on the lookup threads.
+  template <typename Threading, typename... Opts, bool = detail::assert_concurrent<Threading>()>
+  coro_resolver(basic_io_service<Threading>&, Opts&&...) = delete;
+
+public:
+  ///
+  resolve_awaitable resolve(std::string host, uint16_t port)
+  {
+    return { resolver_, std::move(host), port };
+  }
+
+  ///
+  io_service& get_io_service() noexcept
+  {
+    return ios_;
+  }
+
+  ///
+  resolver& get_underlying_resolver() noexcept
+  {
+    return resolver_;
+  }
+
+private:
+  /// The io_service instance
+  io_service& ios_;
+
+  /// The resolver instance
+  resolver resolver_;
+};
+
+} // END namespace coro_async
+
+#endif
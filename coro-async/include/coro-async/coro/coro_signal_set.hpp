@@ -0,0 +1,134 @@
+#ifndef CORO_ASYNC_CORO_SIGNAL_SET_HPP
+#define CORO_ASYNC_CORO_SIGNAL_SET_HPP
+
+#include <experimental/coroutine>
+
+#include "coro-async/io_service.hpp"
+#include "coro-async/signal_set.hpp"
+#include "coro-async/coro/result.hpp"
+
+namespace stdex = std::experimental;
+
+namespace coro_async {
+
+/**
+ * An awaitable for waiting on a `signal_set`.
+ * Completes without suspending if a signal is
+ * already pending.
+ */
+class signal_awaitable
+{
+public:
+  ///
+  signal_awaitable(signal_set& sigs)
+    : sigs_(sigs)
+  {
+  }
+
+  ///
+  signal_awaitable(const signal_awaitable&) = delete;
+  ///
+  signal_awaitable& operator=(const signal_awaitable&) = delete;
+  ///
+  ~signal_awaitable() = default;
+
+public: // Awaitable implementation
+  ///
+  bool await_ready()
+  {
+    return sigs_.read_pending(signo_, ec_) || ec_;
+  }
+
+  /// Waits for the signalfd to become readable.
+  template <typename PromiseType>
+  void await_suspend(stdex::coroutine_handle<PromiseType> ch)
+  {
+    sigs_.async_wait([this, ch](const std::error_code& ec, int signo) {
+                       if (ec) ec_ = ec;
+                       else signo_ = signo;
+                       ch.resume();
+                     });
+  }
+
+  /**
+   * Returns the signal number wrapped inside
+   * `result_type_non_coro`.
+   * In case of error, the wrapped value is the error_code.
+   */
+  result_type_non_coro<int> await_resume() noexcept
+  {
+    if (ec_) return { ec_ };
+    return { signo_ };
+  }
+
+private:
+  /// The signal set
+  signal_set& sigs_;
+
+  /// The received signal
+  int signo_ = 0;
+
+  /// The error in async operation
+  std::error_code ec_;
+};
+
+
+/**
+ * A thin wrapper over `signal_set` providing
+ * an awaitable based interface.
+ */
+class coro_signal_set
+{
+public:
+  ///
+  coro_signal_set(io_executor& ios)
+    : sigs_(ios)
+  {
+  }
+
+  ///
+  coro_signal_set(io_executor& ios, std::initializer_list<int> signals, std::error_code& ec)
+    : sigs_(ios)
+  {
+    for (int signo : signals)
+    {
+      if (!sigs_.add(signo, ec)) return;
+    }
+  }
+
+  ~coro_signal_set() = default;
+
+public:
+  ///
+  bool add(int signo, std::error_code& ec)
+  {
+    return sigs_.add(signo, ec);
+  }
+
+  ///
+  bool remove(int signo, std::error_code& ec)
+  {
+    return sigs_.remove(signo, ec);
+  }
+
+  ///
+  signal_set& get_signal_set() noexcept
+  {
+    return sigs_;
+  }
+
+public: // The awaitables
+  /// Wait for the next signal
+  signal_awaitable wait()
+  {
+    return { sigs_ };
+  }
+
+private:
+  /// The underlying signal set
+  signal_set sigs_;
+};
+
+} // END namespace coro_async
+
+#endif
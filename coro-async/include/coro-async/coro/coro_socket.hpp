@@ -28,6 +28,7 @@
 #include "coro-async/stream_socket.hpp"
 #include "coro-async/coro/read_awaitable.hpp"
 #include "coro-async/coro/write_awaitable.hpp"
+#include "coro-async/coro/fd_passing_awaitable.hpp"
 
 namespace coro_async {
 
@@ -39,7 +40,7 @@ class coro_socket
 {
 public:
   ///
-  coro_socket(io_service& ios)
+  coro_socket(io_executor& ios)
     : ios_(ios)
     , sock_(ios)
   {
@@ -57,7 +58,7 @@ public:
   }
 
   ///
-  io_service& get_io_service() noexcept
+  io_executor& get_io_service() noexcept
   {
     return ios_;
   }
@@ -82,9 +83,27 @@ public: // The awaitables
     return write_awaitable{sock_, bytes, buf};
   }
 
+  /**
+   * Send `nfds` descriptors along with the data in `buf`.
+   * Unix domain sockets only.
+   */
+  auto send_fds(buffer::buffer_ref buf, const int* fds, size_t nfds)
+  {
+    return send_fds_awaitable{sock_, buf, fds, nfds};
+  }
+
+  /**
+   * Receive data into `buf` and upto `max_fds` descriptors into `fds`.
+   * Unix domain sockets only.
+   */
+  auto recv_fds(buffer::buffer_ref buf, int* fds, size_t max_fds)
+  {
+    return recv_fds_awaitable{sock_, buf, fds, max_fds};
+  }
+
 private:
   /// The io_service
-  io_service& ios_;
+  io_executor& ios_;
 
   /// The underlying stream socket
   stream_socket sock_;
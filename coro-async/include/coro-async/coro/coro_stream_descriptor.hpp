@@ -0,0 +1,84 @@
+#ifndef CORO_ASYNC_CORO_STREAM_DESCRIPTOR_HPP
+#define CORO_ASYNC_CORO_STREAM_DESCRIPTOR_HPP
+
+#include "coro-async/buffer_ref.hpp"
+#include "coro-async/io_service.hpp"
+#include "coro-async/posix_stream_descriptor.hpp"
+#include "coro-async/coro/read_awaitable.hpp"
+#include "coro-async/coro/write_awaitable.hpp"
+
+namespace coro_async {
+
+/// Awaitable for reading from a descriptor
+using descriptor_read_awaitable = basic_read_awaitable<posix_stream_descriptor>;
+
+/// Awaitable for writing to a descriptor
+using descriptor_write_awaitable = basic_write_awaitable<posix_stream_descriptor>;
+
+/**
+ * A thin wrapper over `posix_stream_descriptor` for
+ * providing an awaitable based interface for read and write.
+ */
+class coro_stream_descriptor
+{
+public:
+  ///
+  coro_stream_descriptor(io_executor& ios)
+    : ios_(ios)
+    , desc_(ios)
+  {
+  }
+
+  coro_stream_descriptor(coro_stream_descriptor&& other) = default;
+
+  ~coro_stream_descriptor() = default;
+
+public:
+  /// Adopt `fd`. See `posix_stream_descriptor::assign`.
+  bool assign(int fd, std::error_code& ec)
+  {
+    return desc_.assign(fd, ec);
+  }
+
+  ///
+  posix_stream_descriptor& get_descriptor() noexcept
+  {
+    return desc_;
+  }
+
+  ///
+  io_executor& get_io_service() noexcept
+  {
+    return ios_;
+  }
+
+  ///
+  void close()
+  {
+    desc_.close();
+  }
+
+public: // The awaitables
+  ///
+  auto read(size_t bytes, buffer::buffer_ref& buf)
+  {
+    return descriptor_read_awaitable{desc_, bytes, buf};
+  }
+
+  ///
+  auto write(size_t bytes, buffer::buffer_ref& buf)
+  {
+    return descriptor_write_awaitable{desc_, bytes, buf};
+  }
+
+private:
+  /// The io_service
+  io_executor& ios_;
+
+  /// The underlying descriptor
+  posix_stream_descriptor desc_;
+};
+
+} // END namespace coro_async
+
+#endif
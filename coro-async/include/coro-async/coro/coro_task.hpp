@@ -3,8 +3,8 @@
 
 #include <cassert>
 #include <type_traits>
-#include <functional>
 #include <experimental/coroutine>
+#include "coro-async/detail/unique_function.hpp"
 
 namespace stdex = std::experimental;
 
@@ -17,13 +17,13 @@ namespace detail {
 template <typename T>
 struct callback
 {
-  std::function<void(T)> done_cb_ = nullptr;
+  unique_function<void(T)> done_cb_ = nullptr;
 };
 
 template <>
 struct callback<void>
 {
-  std::function<void()> done_cb_ = nullptr;
+  unique_function<void()> done_cb_ = nullptr;
 };
 
 } // END anmespace detail
@@ -39,8 +39,8 @@ struct promise_base : detail::callback<T>
   {
   }
 
-  promise_base(const promise_base&) = default;
-  promise_base& operator=(const promise_base&) = default;
+  promise_base(const promise_base&) = delete;
+  promise_base& operator=(const promise_base&) = delete;
 
   /*!
    * Add done callback which would be executed
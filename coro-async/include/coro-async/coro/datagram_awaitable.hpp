@@ -0,0 +1,174 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_DATAGRAM_AWAITABLE_HPP
+#define CORO_ASYNC_DATAGRAM_AWAITABLE_HPP
+
+#include "coro-async/datagram_batch.hpp"
+#include "coro-async/datagram_socket.hpp"
+#include "coro-async/coro/result.hpp"
+
+namespace stdex = std::experimental;
+
+namespace coro_async {
+
+/**
+ * An awaitable for receiving a batch of datagrams.
+ */
+class receive_batch_awaitable
+{
+public:
+  /**
+   * Constructor.
+   * \param sock - The socket to receive from.
+   * \param batch - The batch to be filled.
+   */
+  receive_batch_awaitable(datagram_socket& sock, datagram_batch& batch)
+    : sock_(sock)
+    , batch_(batch)
+  {
+  }
+
+  ///
+  receive_batch_awaitable(const receive_batch_awaitable&) = delete;
+  ///
+  receive_batch_awaitable& operator=(const receive_batch_awaitable&) = delete;
+  ///
+  ~receive_batch_awaitable() = default;
+
+public: // Awaitable implementation
+  ///
+  bool await_ready()
+  {
+    return false;
+  }
+
+  /// Starts the asynchronous receive operation.
+  template <typename PromiseType>
+  void await_suspend(stdex::coroutine_handle<PromiseType> ch)
+  {
+    sock_.async_receive_batch(
+        batch_, [this, ch](const std::error_code ec, const size_t num_msgs) {
+                  if (ec) ec_ = ec;
+                  else num_msgs_ = num_msgs;
+                  ch.resume();
+                }
+       );
+  }
+
+  /**
+   * Returns the number of datagrams received wrapped
+   * inside `result_type_non_coro` type.
+   * In case of error, the wrapped value is the error_code.
+   */
+  result_type_non_coro<size_t> await_resume()
+  {
+    if (ec_) return { ec_ };
+    else     return { num_msgs_ };
+  }
+
+private:
+  /// The datagram socket
+  datagram_socket& sock_;
+
+  /// The batch to be filled
+  datagram_batch& batch_;
+
+  /// Datagrams received
+  size_t num_msgs_ = 0;
+
+  /// The error in async operation
+  std::error_code ec_;
+};
+
+
+/**
+ * An awaitable for sending a batch of datagrams.
+ */
+class send_batch_awaitable
+{
+public:
+  /**
+   * Constructor.
+   * \param sock - The socket to send on.
+   * \param batch - The messages to be sent.
+   */
+  send_batch_awaitable(datagram_socket& sock, datagram_batch& batch)
+    : sock_(sock)
+    , batch_(batch)
+  {
+  }
+
+  ///
+  send_batch_awaitable(const send_batch_awaitable&) = delete;
+  ///
+  send_batch_awaitable& operator=(const send_batch_awaitable&) = delete;
+  ///
+  ~send_batch_awaitable() = default;
+
+public: // Awaitable implementation
+  ///
+  bool await_ready()
+  {
+    return false;
+  }
+
+  /// Starts the asynchronous send operation.
+  template <typename PromiseType>
+  void await_suspend(stdex::coroutine_handle<PromiseType> ch)
+  {
+    sock_.async_send_batch(
+        batch_, [this, ch](const std::error_code ec, const size_t num_msgs) {
+                  if (ec) ec_ = ec;
+                  else num_msgs_ = num_msgs;
+                  ch.resume();
+                }
+       );
+  }
+
+  /**
+   * Returns the number of datagrams sent wrapped
+   * inside `result_type_non_coro` type.
+   * In case of error, the wrapped value is the error_code.
+   */
+  result_type_non_coro<size_t> await_resume()
+  {
+    if (ec_) return { ec_ };
+    else     return { num_msgs_ };
+  }
+
+private:
+  /// The datagram socket
+  datagram_socket& sock_;
+
+  /// The messages to be sent
+  datagram_batch& batch_;
+
+  /// Datagrams sent
+  size_t num_msgs_ = 0;
+
+  /// The error in async operation
+  std::error_code ec_;
+};
+
+} // END namespace coro_async
+
+#endif
@@ -0,0 +1,212 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_FD_PASSING_AWAITABLE_HPP
+#define CORO_ASYNC_FD_PASSING_AWAITABLE_HPP
+
+#include "coro-async/buffer_ref.hpp"
+#include "coro-async/stream_socket.hpp"
+#include "coro-async/coro/result.hpp"
+
+namespace stdex = std::experimental;
+
+namespace coro_async {
+
+/**
+ * Result of receiving descriptors.
+ */
+struct recv_fds_result
+{
+  /// Bytes of data read
+  size_t bytes_read_ = 0;
+  /// Number of descriptors stored in the caller's array
+  size_t nfds_ = 0;
+};
+
+/**
+ * An awaitable for sending descriptors over a
+ * unix domain socket.
+ */
+class send_fds_awaitable
+{
+public:
+  /**
+   * Constructor.
+   * \param sock - The unix domain socket.
+   * \param buf - The data carrying the descriptors. Must not be empty.
+   * \param fds - The descriptors to send.
+   * \param nfds - Number of descriptors.
+   */
+  send_fds_awaitable(stream_socket& sock, buffer::buffer_ref buf,
+                     const int* fds, size_t nfds)
+    : sock_(sock)
+    , buf_(buf)
+    , fds_(fds)
+    , nfds_(nfds)
+  {
+  }
+
+  ///
+  send_fds_awaitable(const send_fds_awaitable&) = delete;
+  ///
+  send_fds_awaitable& operator=(const send_fds_awaitable&) = delete;
+  ///
+  ~send_fds_awaitable() = default;
+
+public: // Awaitable implementation
+  ///
+  bool await_ready()
+  {
+    return false;
+  }
+
+  /// Starts the asynchronous send operation.
+  template <typename PromiseType>
+  void await_suspend(stdex::coroutine_handle<PromiseType> ch)
+  {
+    sock_.async_send_fds(
+        buf_, fds_, nfds_, [this, ch](const std::error_code ec, const size_t wr_bytes) {
+                             if (ec) ec_ = ec;
+                             else bytes_wrote_ = wr_bytes;
+                             ch.resume();
+                           }
+       );
+  }
+
+  /**
+   * Returns the number of bytes sent wrapped inside
+   * `result_type_non_coro` type.
+   * In case of error, the wrapped value is the error_code.
+   */
+  result_type_non_coro<size_t> await_resume()
+  {
+    if (ec_) return { ec_ };
+    else     return { bytes_wrote_ };
+  }
+
+private:
+  /// The underlying streaming socket reference
+  stream_socket& sock_;
+
+  /// The data buffer
+  buffer::buffer_ref buf_;
+
+  /// The descriptors to send
+  const int* fds_ = nullptr;
+
+  /// Number of descriptors
+  size_t nfds_ = 0;
+
+  /// Bytes sent
+  size_t bytes_wrote_ = 0;
+
+  /// The error in async operation
+  std::error_code ec_;
+};
+
+
+/**
+ * An awaitable for receiving descriptors over a
+ * unix domain socket.
+ */
+class recv_fds_awaitable
+{
+public:
+  /**
+   * Constructor.
+   * \param sock - The unix domain socket.
+   * \param buf - The buffer into which data is read.
+   * \param fds - Where the received descriptors are stored.
+   * \param max_fds - Capacity of `fds`.
+   */
+  recv_fds_awaitable(stream_socket& sock, buffer::buffer_ref buf,
+                     int* fds, size_t max_fds)
+    : sock_(sock)
+    , buf_(buf)
+    , fds_(fds)
+    , max_fds_(max_fds)
+  {
+  }
+
+  ///
+  recv_fds_awaitable(const recv_fds_awaitable&) = delete;
+  ///
+  recv_fds_awaitable& operator=(const recv_fds_awaitable&) = delete;
+  ///
+  ~recv_fds_awaitable() = default;
+
+public: // Awaitable implementation
+  ///
+  bool await_ready()
+  {
+    return false;
+  }
+
+  /// Starts the asynchronous receive operation.
+  template <typename PromiseType>
+  void await_suspend(stdex::coroutine_handle<PromiseType> ch)
+  {
+    sock_.async_recv_fds(
+        buf_, fds_, max_fds_,
+        [this, ch](const std::error_code ec, const size_t rd_bytes, const size_t nfds) {
+          ec_ = ec;
+          res_.bytes_read_ = rd_bytes;
+          res_.nfds_ = nfds;
+          ch.resume();
+        }
+       );
+  }
+
+  /**
+   * Returns the bytes read and descriptors received
+   * wrapped inside `result_type_non_coro` type.
+   * In case of error, the wrapped value is the error_code
+   * and no descriptors are handed out.
+   */
+  result_type_non_coro<recv_fds_result> await_resume()
+  {
+    if (ec_) return { ec_ };
+    else     return { res_ };
+  }
+
+private:
+  /// The underlying streaming socket reference
+  stream_socket& sock_;
+
+  /// The read buffer
+  buffer::buffer_ref buf_;
+
+  /// The descriptors received
+  int* fds_ = nullptr;
+
+  /// Capacity of `fds_`
+  size_t max_fds_ = 0;
+
+  /// The result
+  recv_fds_result res_;
+
+  /// The error in async operation
+  std::error_code ec_;
+};
+
+} // END namespace coro_async
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef CORO_ASYNC_HANDOFF_AWAITABLE_HPP
+#define CORO_ASYNC_HANDOFF_AWAITABLE_HPP
+
+#include <experimental/coroutine>
+
+#include "coro-async/io_service.hpp"
+#include "coro-async/coro/result.hpp"
+#include "coro-async/coro/coro_socket.hpp"
+#include "coro-async/detail/resume_op.hpp"
+
+namespace stdex = std::experimental;
+
+namespace coro_async {
+
+/**
+ * An awaitable which moves a connected socket, along with
+ * the coroutine serving it, over to another io_service.
+ *
+ * The socket is detached from its current io_service before
+ * suspending (see `stream_socket::release`) and re-registered
+ * on the target io_service's thread after the hop, so the two
+ * reactors never see the descriptor at the same time. Data
+ * queued in the kernel is not affected.
+ *
+ * Fails, without hopping, if an operation is pending on the
+ * socket.
+ */
+class handoff_awaitable
+{
+public:
+  ///
+  handoff_awaitable(coro_socket& sock, io_service& target)
+    : sock_(sock)
+    , target_(target)
+  {
+  }
+
+  ///
+  handoff_awaitable(const handoff_awaitable&) = delete;
+  ///
+  handoff_awaitable& operator=(const handoff_awaitable&) = delete;
+  ///
+  ~handoff_awaitable() = default;
+
+public: // Awaitable implementation
+  /// Detaches the socket. Ready if that failed.
+  bool await_ready()
+  {
+    fd_ = sock_.get_stream_sock().release(ec_);
+    return ec_.operator bool();
+  }
+
+  /// Continue on the target io_service.
+  template <typename PromiseType>
+  void await_suspend(stdex::coroutine_handle<PromiseType> ch)
+  {
+    op_.ch_ = ch;
+    target_.post_op(&op_);
+  }
+
+  /**
+   * Returns the socket registered with the target io_service
+   * wrapped inside `result_type_non_coro`.
+   * In case of error, the wrapped value is the error_code.
+   */
+  result_type_non_coro<coro_socket> await_resume()
+  {
+    if (ec_) return { ec_ };
+
+    coro_socket sock{target_};
+    if (!sock.get_stream_sock().assign(fd_, ec_)) return { ec_ };
+    return { std::move(sock) };
+  }
+
+private:
+  /// The socket being moved
+  coro_socket& sock_;
+
+  /// The io_service to move to
+  io_service& target_;
+
+  /// The detached descriptor
+  int fd_ = -1;
+
+  /// Error in detaching or attaching
+  std::error_code ec_;
+
+  /// The embedded resume operation
+  detail::resume_op op_;
+};
+
+/**
+ * `co_await handoff(sock, ios)` continues the coroutine on `ios`
+ * and returns `sock` re-registered there. `sock` is left closed.
+ */
+inline handoff_awaitable handoff(coro_socket& sock, io_service& target)
+{
+  return { sock, target };
+}
+
+/// The socket is re-registered from the source thread.
+template <typename Threading, bool = detail::assert_concurrent<Threading>()>
+void handoff(coro_socket&, basic_io_service<Threading>&) = delete;
+
+} // END namespace coro_async
+
+#endif
@@ -0,0 +1,349 @@
+#ifndef CORO_ASYNC_LOAD_BALANCER_HPP
+#define CORO_ASYNC_LOAD_BALANCER_HPP
+
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <optional>
+#include <experimental/coroutine>
+
+#include "coro-async/endpoint.hpp"
+#include "coro-async/io_service.hpp"
+#include "coro-async/coro/result.hpp"
+#include "coro-async/coro/coro_socket.hpp"
+#include "coro-async/coro/coro_connector.hpp"
+#include "coro-async/coro/connect_awaitable.hpp"
+
+namespace stdex = std::experimental;
+
+namespace coro_async {
+
+/**
+ * Identifies a request dispatched to a backend by
+ * the `load_balancer`. Must be handed back via
+ * `load_balancer::complete` once the request finishes.
+ */
+struct request_token
+{
+  /// Index of the chosen backend
+  size_t backend_ = 0;
+  /// When the request was dispatched
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * A connection to the chosen backend along with the
+ * token of the request it is serving.
+ */
+struct balanced_connection
+{
+  /// The connected socket
+  coro_socket sock_;
+  /// The request token
+  request_token token_;
+};
+
+
+class load_balancer;
+
+/**
+ * An awaitable for connecting to the backend chosen
+ * by the `load_balancer`. The backend is picked only once
+ * the awaitable is awaited, so one which is never awaited
+ * does not hold up an in flight slot.
+ */
+class balanced_connect_awaitable
+{
+public:
+  ///
+  balanced_connect_awaitable(load_balancer& lb);
+
+  ///
+  balanced_connect_awaitable(const balanced_connect_awaitable&) = delete;
+  ///
+  balanced_connect_awaitable& operator=(const balanced_connect_awaitable&) = delete;
+  ///
+  ~balanced_connect_awaitable() = default;
+
+public: // Awaitable implementation
+  ///
+  bool await_ready() const noexcept
+  {
+    return false;
+  }
+
+  /// Picks the backend and starts connecting to it.
+  template <typename PromiseType>
+  void await_suspend(stdex::coroutine_handle<PromiseType> ch)
+  {
+    start_connect();
+    conn_->await_suspend(ch);
+  }
+
+  /**
+   * Returns the connection wrapped inside `result_type_non_coro`.
+   * A failed connect is accounted as a failed request.
+   */
+  result_type_non_coro<balanced_connection> await_resume() noexcept;
+
+private:
+  ///
+  void start_connect();
+
+private:
+  /// The balancer
+  load_balancer& lb_;
+
+  /// Token for the request
+  request_token token_;
+
+  /// The connect operation to the chosen backend
+  std::optional<connect_awaitable> conn_;
+};
+
+
+/**
+ * Client side load balancer using the power of two choices.
+ *
+ * For every request two distinct backends are picked at random
+ * and the one with the lower load is chosen. The load of a
+ * backend is its peak EWMA latency scaled by the number of
+ * in flight requests on it, so a backend which slows down
+ * quickly stops receiving traffic even if it is not queueing.
+ *
+ * NOTE: Not thread safe. To be used only from the thread
+ * running the io_service.
+ */
+class load_balancer
+{
+public:
+  /// The clock used for latency measurement
+  using clock_type = std::chrono::steady_clock;
+
+public:
+  /**
+   * Constructor.
+   * \param ios - The io_service on which connections are made.
+   * \param backends - The backend endpoints. Must not be empty.
+   * \param decay - Time constant of the latency EWMA.
+   * \param failure_penalty - Latency accounted for a failed request.
+   */
+  load_balancer(io_executor& ios,
+                std::vector<endpoint> backends,
+                std::chrono::milliseconds decay = std::chrono::seconds(10),
+                std::chrono::milliseconds failure_penalty = std::chrono::seconds(1))
+    : ios_(ios)
+    , connector_(ios)
+    , decay_ns_(std::chrono::duration<double, std::nano>(decay).count())
+    , penalty_ns_(std::chrono::duration<double, std::nano>(failure_penalty).count())
+    , rng_(std::random_device{}())
+  {
+    assert (!backends.empty() && "Need atleast one backend");
+
+    const auto now = clock_type::now();
+    backends_.reserve(backends.size());
+    for (auto& ep : backends)
+    {
+      backends_.push_back({ std::move(ep), 0, 0.0, now });
+    }
+  }
+
+  ///
+  load_balancer(const load_balancer&) = delete;
+  load_balancer& operator=(const load_balancer&) = delete;
+
+public:
+  /// Pick a backend and connect to it.
+  balanced_connect_awaitable connect()
+  {
+    return { *this };
+  }
+
+  /**
+   * Pick a backend for a new request and account it
+   * as in flight. Use this directly when the connection
+   * is obtained by other means, e.g. a `connection_pool`.
+   */
+  request_token pick()
+  {
+    const size_t n = backends_.size();
+    const auto now = clock_type::now();
+    size_t chosen = 0;
+
+    if (n > 1)
+    {
+      std::uniform_int_distribution<size_t> dist{0, n - 1};
+      size_t a = dist(rng_);
+      size_t b = dist(rng_);
+      while (b == a) b = dist(rng_);
+
+      chosen = load(a, now) <= load(b, now) ? a : b;
+    }
+
+    backends_[chosen].in_flight_++;
+    return { chosen, now };
+  }
+
+  /**
+   * Finish the request identified by `token`.
+   * Its latency is folded into the backend EWMA.
+   * \param ok - false if the request failed.
+   */
+  void complete(const request_token& token, bool ok = true)
+  {
+    assert (token.backend_ < backends_.size());
+    auto& b = backends_[token.backend_];
+    assert (b.in_flight_ > 0);
+    b.in_flight_--;
+
+    const auto now = clock_type::now();
+    double rtt = std::chrono::duration<double, std::nano>(now - token.start_).count();
+    if (!ok) rtt = std::max(rtt, penalty_ns_);
+
+    update_ewma(b, rtt, now);
+  }
+
+  /// Get the endpoint of the backend chosen for `token`.
+  const endpoint& backend(const request_token& token) const noexcept
+  {
+    return backends_[token.backend_].ep_;
+  }
+
+  /// Number of backends.
+  size_t size() const noexcept
+  {
+    return backends_.size();
+  }
+
+  /// Number of in flight requests on backend `idx`.
+  size_t in_flight(size_t idx) const noexcept
+  {
+    return backends_[idx].in_flight_;
+  }
+
+  /// Current (decayed) latency EWMA of backend `idx`.
+  std::chrono::nanoseconds latency(size_t idx) const noexcept
+  {
+    const auto& b = backends_[idx];
+    const double lat = b.ewma_ns_ * decay_weight(b, clock_type::now());
+    return std::chrono::nanoseconds(static_cast<int64_t>(lat));
+  }
+
+  ///
+  coro_connector& get_connector() noexcept
+  {
+    return connector_;
+  }
+
+  ///
+  io_executor& get_io_service() noexcept
+  {
+    return ios_;
+  }
+
+private:
+  /// Book keeping for each backend
+  struct backend_state
+  {
+    /// The backend endpoint
+    endpoint ep_;
+    /// Requests dispatched but not yet completed
+    size_t in_flight_ = 0;
+    /// Latency EWMA in nanoseconds
+    double ewma_ns_ = 0.0;
+    /// When the EWMA was last updated
+    clock_type::time_point last_update_;
+  };
+
+  /**
+   * How much of the EWMA is left at `now`. The EWMA is decayed
+   * by the time since its last update so that a backend which
+   * got penalised is probed again later.
+   */
+  double decay_weight(const backend_state& b, clock_type::time_point now) const noexcept
+  {
+    const double dt = std::chrono::duration<double, std::nano>(now - b.last_update_).count();
+    return std::exp(-dt / decay_ns_);
+  }
+
+  /// The load score. Lower is better.
+  double load(size_t idx, clock_type::time_point now) const noexcept
+  {
+    const auto& b = backends_[idx];
+    double lat = b.ewma_ns_ * decay_weight(b, now);
+    // An unmeasured backend gets a nominal latency so that
+    // in flight requests still spread the load.
+    if (lat < 1.0) lat = 1.0;
+    return lat * static_cast<double>(b.in_flight_ + 1);
+  }
+
+  /**
+   * Peak EWMA: latency spikes are taken immediately,
+   * improvements decay in over `decay_ns_`. The sample is
+   * compared against the same decayed value `load` uses.
+   */
+  void update_ewma(backend_state& b, double rtt, clock_type::time_point now)
+  {
+    const double w = decay_weight(b, now);
+    const double cur = b.ewma_ns_ * w;
+    if (rtt > cur)
+    {
+      b.ewma_ns_ = rtt;
+    }
+    else
+    {
+      b.ewma_ns_ = b.ewma_ns_ * w + rtt * (1.0 - w);
+    }
+    b.last_update_ = now;
+  }
+
+private:
+  /// The io_service instance
+  io_executor& ios_;
+
+  /// Connector used for reaching the backends
+  coro_connector connector_;
+
+  /// The backends
+  std::vector<backend_state> backends_;
+
+  /// EWMA decay time constant in nanoseconds
+  double decay_ns_ = 0.0;
+
+  /// Latency accounted for a failed request in nanoseconds
+  double penalty_ns_ = 0.0;
+
+  /// Random source for picking the candidates
+  std::minstd_rand rng_;
+};
+
+//================================================================================
+
+inline balanced_connect_awaitable::balanced_connect_awaitable(load_balancer& lb)
+  : lb_(lb)
+{
+}
+
+inline void balanced_connect_awaitable::start_connect()
+{
+  token_ = lb_.pick();
+  conn_.emplace(lb_.get_io_service(), lb_.backend(token_));
+}
+
+inline result_type_non_coro<balanced_connection>
+balanced_connect_awaitable::await_resume() noexcept
+{
+  auto res = conn_->await_resume();
+  if (res.is_error())
+  {
+    lb_.complete(token_, false);
+    return { res.error() };
+  }
+  return balanced_connection{ std::move(res.result()), token_ };
+}
+
+} // END namespace coro_async
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef CORO_ASYNC_OFFLOAD_AWAITABLE_HPP
+#define CORO_ASYNC_OFFLOAD_AWAITABLE_HPP
+
+#include <optional>
+#include <exception>
+#include <type_traits>
+#include <experimental/coroutine>
+
+#include "coro-async/io_service.hpp"
+#include "coro-async/thread_pool.hpp"
+#include "coro-async/coro/result.hpp"
+#include "coro-async/detail/meta.hpp"
+#include "coro-async/detail/resume_op.hpp"
+#include "coro-async/detail/operation_base.hpp"
+
+namespace stdex = std::experimental;
+
+namespace coro_async {
+
+template <typename Fn>
+class offload_awaitable;
+
+namespace detail {
+
+/**
+ * Runs the offloaded function on the pool and
+ * posts the resumption back to the io_service.
+ */
+template <typename Fn>
+class offload_op: public operation_base
+{
+public:
+  ///
+  offload_op(offload_awaitable<Fn>& awaitable)
+    : operation_base(offload_op<Fn>::complete)
+    , awaitable_(awaitable)
+  {
+  }
+
+  /// Called on a pool thread.
+  static void complete(operation_base* op, const std::error_code& ec, size_t bytes_xferred)
+  {
+    static_cast<offload_op<Fn>*>(op)->awaitable_.run_on_pool();
+  }
+
+private:
+  /// The awaitable owning this op
+  offload_awaitable<Fn>& awaitable_;
+};
+
+} // END namespace detail
+
+
+/**
+ * An awaitable which runs `Fn` on a `thread_pool` and resumes
+ * the coroutine back on the io_service once it returns.
+ *
+ * Like `coro_scheduler::wait_for`, the result is a
+ * `result_type_non_coro<T>` for a function returning T and
+ * `result_type_non_coro_void` for one returning void. An
+ * exception thrown by the function is rethrown in the coroutine.
+ *
+ * Both the hop to the pool and the hop back use operations
+ * embedded in the awaitable, so nothing is allocated.
+ */
+template <typename Fn>
+class offload_awaitable
+{
+public:
+  /// The return type of `Fn`
+  using value_type = std::invoke_result_t<Fn&>;
+
+  static_assert(!detail::meta::is_coro_task<value_type>::value,
+                "Coroutines need not be offloaded. Use `wait_for`.");
+
+  /// The result of the await
+  using result_type = std::conditional_t<std::is_void<value_type>{},
+                                         result_type_non_coro_void,
+                                         result_type_non_coro<value_type>>;
+
+  ///
+  offload_awaitable(io_service& ios, thread_pool& pool, Fn&& fn,
+                    priority prio = priority::normal)
+    : ios_(ios)
+    , pool_(pool)
+    , prio_(prio)
+    , fn_(std::forward<Fn>(fn))
+    , pool_op_(*this)
+  {
+  }
+
+  ///
+  offload_awaitable(const offload_awaitable&) = delete;
+  ///
+  offload_awaitable& operator=(const offload_awaitable&) = delete;
+  ///
+  ~offload_awaitable() = default;
+
+public: // Awaitable implementation
+  ///
+  bool await_ready() const noexcept
+  {
+    return false;
+  }
+
+  /// Hands the function over to the pool.
+  template <typename PromiseType>
+  void await_suspend(stdex::coroutine_handle<PromiseType> ch)
+  {
+    resume_op_.ch_ = ch;
+    pool_.post_op(&pool_op_);
+  }
+
+  ///
+  result_type await_resume()
+  {
+    if (exc_) std::rethrow_exception(exc_);
+
+    if constexpr (std::is_void<value_type>{})
+    {
+      return result_type{};
+    }
+    else
+    {
+      return { std::move(*value_) };
+    }
+  }
+
+private:
+  friend class detail::offload_op<Fn>;
+
+  /// Runs on a pool thread.
+  void run_on_pool()
+  {
+    try
+    {
+      if constexpr (std::is_void<value_type>{}) fn_();
+      else                                     value_.emplace(fn_());
+    }
+    catch (...)
+    {
+      exc_ = std::current_exception();
+    }
+    // The posting thread synchronizes the writes above
+    // with the resumption on the io_service thread.
+    ios_.post_op(&resume_op_, prio_);
+  }
+
+private:
+  /// The io_service to resume on
+  io_service& ios_;
+
+  /// The pool to run on
+  thread_pool& pool_;
+
+  /// Priority of the resumption
+  priority prio_;
+
+  /// The function
+  std::decay_t<Fn> fn_;
+
+  /// The value returned by `fn_`
+  std::optional<std::conditional_t<std::is_void<value_type>{}, char, value_type>> value_;
+
+  /// The exception thrown by `fn_`
+  std::exception_ptr exc_;
+
+  /// Runs `fn_` on the pool
+  detail::offload_op<Fn> pool_op_;
+
+  /// Resumes the coroutine on the io_service
+  detail::resume_op resume_op_;
+};
+
+/**
+ * `co_await offload(ios, pool, fn)` runs `fn` on `pool` and
+ * continues the coroutine on `ios`, with priority `prio`.
+ */
+template <typename Fn>
+offload_awaitable<Fn> offload(io_service& ios, thread_pool& pool, Fn&& fn,
+                              priority prio = priority::normal)
+{
+  return { ios, pool, std::forward<Fn>(fn), prio };
+}
+
+/// The coroutine is resumed from the pool thread.
+template <typename Threading, typename Fn, bool = detail::assert_concurrent<Threading>()>
+void offload(basic_io_service<Threading>&, thread_pool&, Fn&&,
+             priority = priority::normal) = delete;
+
+} // END namespace coro_async
+
+#endif
@@ -32,8 +32,10 @@ namespace coro_async {
 
 /**
  * An awaitable class for performing socket read operation.
+ * `Stream` is `stream_socket` or `posix_stream_descriptor`.
  */
-class read_awaitable
+template <typename Stream>
+class basic_read_awaitable
 {
 public:
   /**
@@ -42,7 +44,7 @@ public:
    * \param read_bytes - Number of bytes to read.
    * \param buf - The buffer into which the data needs to be wrote into.
    */
-  read_awaitable(stream_socket& sock, size_t read_bytes, buffer::buffer_ref buf)
+  basic_read_awaitable(Stream& sock, size_t read_bytes, buffer::buffer_ref buf)
     : sock_(sock)
     , bytes_to_read_(read_bytes)
     , read_buf_(buf)
@@ -51,11 +53,11 @@ public:
   }
 
   ///
-  read_awaitable(const read_awaitable&) = delete;
+  basic_read_awaitable(const basic_read_awaitable&) = delete;
   ///
-  read_awaitable& operator=(const read_awaitable&) = delete;
+  basic_read_awaitable& operator=(const basic_read_awaitable&) = delete;
   ///
-  ~read_awaitable() = default;
+  ~basic_read_awaitable() = default;
 
 public: // Awaitable implementation
   ///
@@ -104,7 +106,7 @@ private: // hidden implementation
 
 private:
   /// The underlying streaming socket reference
-  stream_socket& sock_;
+  Stream& sock_;
 
   /// Exact bytes to be read
   const size_t bytes_to_read_ = 0;
@@ -119,6 +121,9 @@ private:
   std::error_code ec_;
 };
 
+/// Awaitable for reading from a socket
+using read_awaitable = basic_read_awaitable<stream_socket>;
+
 } // END namespace coro_async
 
 
@@ -24,6 +24,7 @@
 #define CORO_ASYNC_RESULT_HPP
 
 #include <variant>
+#include <type_traits>
 #include <system_error>
 #include "coro-async/detail/meta.hpp"
 #include "coro-async/coro/coro_task.hpp"
@@ -37,6 +38,13 @@ template <typename T>
 struct result_type_non_coro
 {
 public:
+  /// Before the task has run. Only for default constructible `T`.
+  template <typename U = T,
+            typename = std::enable_if_t<std::is_default_constructible<U>::value>>
+  result_type_non_coro()
+  {
+  }
+
   ///
   // TODO: Should allow convertible types too ?
   result_type_non_coro(
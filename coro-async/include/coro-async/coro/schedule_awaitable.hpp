@@ -29,6 +29,7 @@
 #include "coro-async/io_service.hpp"
 #include "coro-async/coro/result.hpp"
 #include "coro-async/detail/meta.hpp"
+#include "coro-async/detail/resume_op.hpp"
 
 
 namespace stdex = std::experimental;
@@ -43,14 +44,14 @@ class timed_schedule_awaitable
 {
 public:
   ///
-  timed_schedule_awaitable(io_service& ios, std::chrono::milliseconds d)
+  timed_schedule_awaitable(io_executor& ios, std::chrono::milliseconds d)
     : ios_(ios)
     , duration_(d)
   {
   }
 
   ///
-  timed_schedule_awaitable(io_service& ios, std::chrono::seconds d)
+  timed_schedule_awaitable(io_executor& ios, std::chrono::seconds d)
     : ios_(ios)
     , duration_(std::chrono::milliseconds(d))
   {
@@ -84,7 +85,7 @@ public: // Awaitable interface
 
 public:
   /// The io_service reference
-  io_service& ios_;
+  io_executor& ios_;
 
   /// Duration / Time interval
   std::chrono::milliseconds duration_;
@@ -92,6 +93,144 @@ public:
 
 //================================================================================
 
+/**
+ * An awaitable which continues the coroutine on the
+ * thread running another io_service.
+ *
+ * The coroutine handle is queued on the target scheduler
+ * through an operation embedded in the awaitable, so a hop
+ * costs one locked queue push and no allocation.
+ */
+class schedule_on_awaitable
+{
+public:
+  ///
+  schedule_on_awaitable(io_service& ios, priority prio = priority::normal)
+    : ios_(ios)
+    , prio_(prio)
+  {
+  }
+
+  ///
+  schedule_on_awaitable(const schedule_on_awaitable&) = delete;
+  schedule_on_awaitable& operator=(const schedule_on_awaitable&) = delete;
+
+public: // Awaitable interface
+  ///
+  bool await_ready() const noexcept
+  {
+    return false;
+  }
+
+  /// Queue the resumption on the target io_service.
+  template <typename PromiseType>
+  void await_suspend(stdex::coroutine_handle<PromiseType> ch)
+  {
+    op_.ch_ = ch;
+    ios_.post_op(&op_, prio_);
+  }
+
+  ///
+  void await_resume() const noexcept
+  {
+  }
+
+private:
+  /// The target io_service
+  io_service& ios_;
+
+  /// Priority of the resumption
+  priority prio_;
+
+  /// The embedded resume operation
+  detail::resume_op op_;
+};
+
+/**
+ * `co_await schedule_on(ios)` continues the coroutine on `ios`.
+ * With `priority::high` it is resumed ahead of the normal
+ * work queued there.
+ */
+inline schedule_on_awaitable schedule_on(io_service& ios, priority prio = priority::normal)
+{
+  return { ios, prio };
+}
+
+/// The hop is posted from the thread of the coroutine.
+template <typename Threading, bool = detail::assert_concurrent<Threading>()>
+void schedule_on(basic_io_service<Threading>&, priority = priority::normal) = delete;
+
+//================================================================================
+
+/**
+ * An awaitable which lets the other work of the io_service
+ * run before continuing the coroutine.
+ *
+ * The coroutine is re-queued for the next loop iteration through
+ * an operation embedded in the awaitable: the reactor is polled
+ * and the handlers queued before it run first. No timer and no
+ * allocation is involved. Completes right away if not awaited
+ * on a thread running an io_service.
+ */
+class yield_awaitable
+{
+public:
+  ///
+  yield_awaitable(io_executor* ios)
+    : ios_(ios)
+  {
+  }
+
+  ///
+  yield_awaitable(const yield_awaitable&) = delete;
+  yield_awaitable& operator=(const yield_awaitable&) = delete;
+
+public: // Awaitable interface
+  ///
+  bool await_ready() const noexcept
+  {
+    return ios_ == nullptr;
+  }
+
+  /// Queue the resumption for the next loop iteration.
+  template <typename PromiseType>
+  void await_suspend(stdex::coroutine_handle<PromiseType> ch)
+  {
+    op_.ch_ = ch;
+    ios_->defer_op(&op_);
+  }
+
+  ///
+  void await_resume() const noexcept
+  {
+  }
+
+private:
+  /// The io_service to yield to
+  io_executor* ios_;
+
+  /// The embedded resume operation
+  detail::resume_op op_;
+};
+
+/**
+ * `co_await yield()` lets the io_service running the calling
+ * thread do its other work before the coroutine continues.
+ * Meant for long running coroutines to share the loop.
+ */
+inline yield_awaitable yield()
+{
+  return { io_service::current() };
+}
+
+/// `co_await yield(ios)` yields to `ios`, continuing on it.
+inline yield_awaitable yield(io_executor& ios)
+{
+  return { &ios };
+}
+
+//================================================================================
+
 /**
  * An awaitable interface for completing the task.
  * The task itself could be a coroutine. In such cases,
@@ -115,9 +254,11 @@ public:
   using result_type = typename deduce_result_type<Handler>::type;
 
   ///
-  task_completion_awaitable(io_service& ios, Handler&& h)
+  task_completion_awaitable(io_executor& ios, Handler&& h,
+                            priority prio = priority::normal)
     : result_type()
     , ios_(ios)
+    , prio_(prio)
     , handler_(std::forward<Handler>(h))
   {
   }
@@ -154,7 +295,8 @@ public: // Awaitable interface
                       {
                         result_type::construct(std::move(result));
                         ch.resume();
-                      }
+                      },
+                      this->prio_
                     );
               }
             );
@@ -168,7 +310,8 @@ public: // Awaitable interface
                       [ch]() mutable
                       {
                         ch.resume();
-                      }
+                      },
+                      this->prio_
                     );
               }
             );
@@ -176,7 +319,7 @@ public: // Awaitable interface
     }
     else
     {
-      ios_.post([this, ch]() { this->task_completed(ch); });
+      ios_.post([this, ch]() { this->task_completed(ch); }, prio_);
     }
   }
 
@@ -213,7 +356,10 @@ private:
 
 public:
   /// The io_service reference
-  io_service& ios_;
+  io_executor& ios_;
+
+  /// Priority of the task and of the resumption
+  priority prio_;
 
   /// Final handler
   Handler handler_;
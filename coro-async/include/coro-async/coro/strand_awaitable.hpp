@@ -0,0 +1,71 @@
+#ifndef CORO_ASYNC_STRAND_AWAITABLE_HPP
+#define CORO_ASYNC_STRAND_AWAITABLE_HPP
+
+#include <experimental/coroutine>
+
+#include "coro-async/strand.hpp"
+#include "coro-async/detail/resume_op.hpp"
+
+namespace stdex = std::experimental;
+
+namespace coro_async {
+
+/**
+ * An awaitable which resumes the coroutine on a strand.
+ * The code up to the next suspension point is serialized
+ * with the other handlers of the strand. Completions of
+ * operations awaited after that do not run on the strand.
+ */
+class strand_awaitable
+{
+public:
+  ///
+  strand_awaitable(strand& s)
+    : strand_(s)
+  {
+  }
+
+  ///
+  strand_awaitable(const strand_awaitable&) = delete;
+  ///
+  strand_awaitable& operator=(const strand_awaitable&) = delete;
+  ///
+  ~strand_awaitable() = default;
+
+public: // Awaitable implementation
+  ///
+  bool await_ready() const noexcept
+  {
+    return false;
+  }
+
+  ///
+  template <typename PromiseType>
+  void await_suspend(stdex::coroutine_handle<PromiseType> ch)
+  {
+    op_.ch_ = ch;
+    strand_.post_op(&op_);
+  }
+
+  ///
+  void await_resume() const noexcept
+  {
+  }
+
+private:
+  /// The strand to resume on
+  strand& strand_;
+
+  /// The embedded operation
+  detail::resume_op op_;
+};
+
+/// `co_await resume_on(s)` continues the coroutine on strand `s`.
+inline strand_awaitable resume_on(strand& s)
+{
+  return { s };
+}
+
+} // END namespace coro_async
+
+#endif
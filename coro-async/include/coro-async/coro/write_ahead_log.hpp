@@ -0,0 +1,448 @@
+#ifndef CORO_ASYNC_WRITE_AHEAD_LOG_HPP
+#define CORO_ASYNC_WRITE_AHEAD_LOG_HPP
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+#include <experimental/coroutine>
+
+#include "coro-async/io_service.hpp"
+#include "coro-async/buffer_ref.hpp"
+#include "coro-async/thread_pool.hpp"
+#include "coro-async/coro/result.hpp"
+#include "coro-async/detail/operation_base.hpp"
+#include "coro-async/detail/operation_queue.hpp"
+
+namespace stdex = std::experimental;
+
+namespace coro_async {
+
+class write_ahead_log;
+
+namespace detail {
+
+/**
+ * A pending append. Lives inside the awaitable (i.e. in the
+ * coroutine frame), so queueing an append never allocates.
+ */
+class wal_append_op: public operation_base
+{
+public:
+  ///
+  wal_append_op(buffer::buffer_ref rec)
+    : operation_base(wal_append_op::complete)
+    , record_(rec)
+  {
+  }
+
+  /// Resumes the appending coroutine once its batch is durable.
+  static void complete(operation_base* op, const std::error_code& ec, size_t bytes_xferred)
+  {
+    auto self = static_cast<wal_append_op*>(op);
+    self->ec_ = ec;
+    self->ch_.resume();
+  }
+
+public:
+  /// The record to append
+  buffer::buffer_ref record_;
+  /// Offset of the record in the log
+  uint64_t offset_ = 0;
+  /// The result of the group commit
+  std::error_code ec_;
+  /// The suspended coroutine
+  stdex::coroutine_handle<> ch_ = nullptr;
+};
+
+} // END namespace detail
+
+
+/**
+ * An awaitable for appending a record to the
+ * `write_ahead_log`. Resumes once the record is on disk.
+ */
+class wal_append_awaitable
+{
+public:
+  ///
+  wal_append_awaitable(write_ahead_log& log, buffer::buffer_ref rec)
+    : log_(log)
+    , op_(rec)
+  {
+  }
+
+  ///
+  wal_append_awaitable(const wal_append_awaitable&) = delete;
+  ///
+  wal_append_awaitable& operator=(const wal_append_awaitable&) = delete;
+  ///
+  ~wal_append_awaitable() = default;
+
+public: // Awaitable implementation
+  /// Ready (with the error) if the log has already failed.
+  bool await_ready();
+
+  /// Queue up for the next group commit.
+  template <typename PromiseType>
+  void await_suspend(stdex::coroutine_handle<PromiseType> ch)
+  {
+    op_.ch_ = ch;
+    enqueue();
+  }
+
+  /**
+   * Returns the offset of the record in the log wrapped
+   * inside `result_type_non_coro`.
+   * In case of error, the wrapped value is the error_code.
+   */
+  result_type_non_coro<uint64_t> await_resume() noexcept
+  {
+    if (op_.ec_) return { op_.ec_ };
+    return { op_.offset_ };
+  }
+
+private:
+  ///
+  void enqueue();
+
+private:
+  /// The log
+  write_ahead_log& log_;
+
+  /// The embedded append operation
+  detail::wal_append_op op_;
+};
+
+
+/**
+ * An append only log with group commit.
+ *
+ * Appends are queued and written out in batches: one `writev`
+ * followed by one `fdatasync` per batch, run on a `thread_pool`.
+ * While a batch is being synced, new appends collect into the
+ * next batch. Every appender of a batch is resumed on the
+ * io_service thread once the batch is durable.
+ *
+ * An I/O error fails the batch and is sticky: the log refuses
+ * all further appends since its tail is in an unknown state.
+ *
+ * NOTE: Not thread safe. To be used only from the thread
+ * running the io_service. The record buffers must stay valid
+ * till the append completes.
+ */
+class write_ahead_log
+{
+public:
+  /// Tuning of the group commit
+  struct options
+  {
+    /// Upper bound on the bytes written by one batch
+    size_t max_batch_bytes = 4 * 1024 * 1024;
+    /**
+     * How long the first append of an idle log waits for
+     * more appends before the batch is written. 0 only waits
+     * for the handlers already queued on the io_service.
+     */
+    std::chrono::milliseconds commit_delay{0};
+    /// fdatasync (true) or fsync (false)
+    bool data_sync = true;
+  };
+
+public:
+  ///
+  write_ahead_log(io_service& ios, thread_pool& pool)
+    : write_ahead_log(ios, pool, options{})
+  {
+  }
+
+  ///
+  write_ahead_log(io_service& ios, thread_pool& pool, options opts)
+    : ios_(ios)
+    , pool_(pool)
+    , opts_(opts)
+  {
+  }
+
+  /// The commits complete on the pool threads.
+  template <typename Threading, typename... Opts, bool = detail::assert_concurrent<Threading>()>
+  write_ahead_log(basic_io_service<Threading>&, thread_pool&, Opts&&...) = delete;
+
+  write_ahead_log(const write_ahead_log&) = delete;
+  write_ahead_log& operator=(const write_ahead_log&) = delete;
+
+  /// Must not be destroyed while appends are pending.
+  ~write_ahead_log();
+
+public:
+  /**
+   * Open (or create) the log file for appending.
+   * Blocking, meant to be called once at start up.
+   */
+  bool open(const std::string& path, std::error_code& ec);
+
+  /// Append `rec` to the log.
+  wal_append_awaitable append(buffer::buffer_ref rec)
+  {
+    return { *this, rec };
+  }
+
+  /// Bytes known to be on disk
+  uint64_t durable_size() const noexcept
+  {
+    return durable_offset_;
+  }
+
+  /// Number of batches synced so far
+  uint64_t commits() const noexcept
+  {
+    return commits_;
+  }
+
+  /// The sticky error, if the log has failed.
+  const std::error_code& error() const noexcept
+  {
+    return failed_;
+  }
+
+  ///
+  io_service& get_io_service() noexcept
+  {
+    return ios_;
+  }
+
+private:
+  friend class wal_append_awaitable;
+
+  /// Add `op` to the next batch.
+  void enqueue(detail::wal_append_op* op);
+
+  /// Arrange for `start_flush` to run.
+  void schedule_flush();
+
+  /// Write out the next batch if none is in flight.
+  void start_flush();
+
+  /// Blocking writev + sync of the batch. Runs on the pool.
+  std::error_code write_batch();
+
+  /// Called on the io_service thread once the batch is done.
+  void on_flush_done(const std::error_code& ec, uint64_t batch_end);
+
+private:
+  /// The io_service
+  io_service& ios_;
+
+  /// The pool doing the blocking calls
+  thread_pool& pool_;
+
+  /// Tuning
+  options opts_;
+
+  /// The log file descriptor
+  int fd_ = -1;
+
+  /// Appends waiting for the next batch
+  operation_queue<detail::operation_base> pending_;
+
+  /// Appends of the batch in flight
+  operation_queue<detail::operation_base> flushing_;
+
+  /// The iovecs of the batch in flight. Reused across batches.
+  std::vector<iovec> iov_;
+
+  /// Offset at which the next record goes
+  uint64_t next_offset_ = 0;
+
+  /// Offset upto which the log is durable
+  uint64_t durable_offset_ = 0;
+
+  /// Number of batches synced
+  uint64_t commits_ = 0;
+
+  /// Is a batch being written
+  bool flush_in_flight_ = false;
+
+  /// Is `start_flush` already scheduled
+  bool flush_scheduled_ = false;
+
+  /// Sticky I/O error
+  std::error_code failed_;
+};
+
+//================================================================================
+
+inline bool wal_append_awaitable::await_ready()
+{
+  if (!log_.failed_) return false;
+  op_.ec_ = log_.failed_;
+  return true;
+}
+
+inline void wal_append_awaitable::enqueue()
+{
+  log_.enqueue(&op_);
+}
+
+inline write_ahead_log::~write_ahead_log()
+{
+  assert (!flush_in_flight_ && pending_.is_empty() &&
+          "Log destroyed with appends pending");
+  if (fd_ != -1) ::close(fd_);
+}
+
+inline bool write_ahead_log::open(const std::string& path, std::error_code& ec)
+{
+  ec.clear();
+  assert (fd_ == -1);
+
+  fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+  if (fd_ == -1)
+  {
+    ec = std::error_code{errno, std::system_category()};
+    return false;
+  }
+
+  struct stat st;
+  if (::fstat(fd_, &st) != 0)
+  {
+    ec = std::error_code{errno, std::system_category()};
+    ::close(fd_);
+    fd_ = -1;
+    return false;
+  }
+
+  next_offset_ = durable_offset_ = st.st_size;
+  return true;
+}
+
+inline void write_ahead_log::enqueue(detail::wal_append_op* op)
+{
+  assert (fd_ != -1 && "Log is not open");
+
+  op->offset_ = next_offset_;
+  next_offset_ += op->record_.size();
+  pending_.push(op);
+
+  if (!flush_in_flight_) schedule_flush();
+}
+
+inline void write_ahead_log::schedule_flush()
+{
+  if (flush_scheduled_) return;
+  flush_scheduled_ = true;
+
+  auto flush = [this]() {
+    flush_scheduled_ = false;
+    this->start_flush();
+  };
+
+  // Let the appends which are already runnable, or are made
+  // runnable by the current reactor batch, join the batch
+  if (opts_.commit_delay.count() == 0) ios_.defer(std::move(flush));
+  else                                 ios_.schedule_after(opts_.commit_delay, std::move(flush));
+}
+
+inline void write_ahead_log::start_flush()
+{
+  if (flush_in_flight_ || pending_.is_empty()) return;
+
+  // Cut the batch at `max_batch_bytes` (but take atleast one record)
+  size_t batch_bytes = 0;
+  uint64_t batch_end = 0;
+  iov_.clear();
+
+  while (!pending_.is_empty())
+  {
+    auto op = static_cast<detail::wal_append_op*>(pending_.head());
+    const size_t len = op->record_.size();
+    if (!iov_.empty() && batch_bytes + len > opts_.max_batch_bytes) break;
+
+    pending_.pop();
+    flushing_.push(op);
+
+    iov_.push_back({ op->record_.data(), len });
+    batch_bytes += len;
+    batch_end = op->offset_ + len;
+  }
+
+  flush_in_flight_ = true;
+
+  pool_.post([this, batch_end]() {
+    auto ec = this->write_batch();
+    ios_.post([this, ec, batch_end]() { this->on_flush_done(ec, batch_end); });
+  });
+}
+
+inline std::error_code write_ahead_log::write_batch()
+{
+  size_t idx = 0;
+  while (idx < iov_.size())
+  {
+    const int cnt = static_cast<int>(std::min<size_t>(iov_.size() - idx, IOV_MAX));
+    ssize_t wbytes = ::writev(fd_, &iov_[idx], cnt);
+    if (wbytes < 0)
+    {
+      if (errno == EINTR) continue;
+      return std::error_code{errno, std::system_category()};
+    }
+
+    // Skip past what got written, fix up a partially written iovec
+    size_t left = wbytes;
+    while (idx < iov_.size() && left >= iov_[idx].iov_len)
+    {
+      left -= iov_[idx].iov_len;
+      idx++;
+    }
+    if (left)
+    {
+      iov_[idx].iov_base = static_cast<char*>(iov_[idx].iov_base) + left;
+      iov_[idx].iov_len -= left;
+    }
+  }
+
+  int rc = opts_.data_sync ? ::fdatasync(fd_) : ::fsync(fd_);
+  if (rc != 0) return std::error_code{errno, std::system_category()};
+
+  return {};
+}
+
+inline void write_ahead_log::on_flush_done(const std::error_code& ec, uint64_t batch_end)
+{
+  flush_in_flight_ = false;
+
+  if (ec)
+  {
+    failed_ = ec;
+    // Nothing behind a failed batch can be trusted either
+    flushing_.push(pending_);
+  }
+  else
+  {
+    durable_offset_ = batch_end;
+    commits_++;
+  }
+
+  // The resumed coroutines may append again. Those go to
+  // the next batch, which is started right away.
+  operation_queue<detail::operation_base> done;
+  done.push(flushing_);
+  if (!pending_.is_empty()) start_flush();
+
+  while (!done.is_empty())
+  {
+    auto op = done.pop();
+    op->call(op, failed_, 0);
+  }
+}
+
+} // END namespace coro_async
+
+#endif
@@ -7,12 +7,15 @@
 namespace coro_async {
 
 /**
+ * An awaitable for writing all of the buffer to a
+ * `stream_socket` or `posix_stream_descriptor`.
  */
-class write_awaitable
+template <typename Stream>
+class basic_write_awaitable
 {
 public:
   ///
-  write_awaitable(stream_socket& sock, size_t write_bytes, buffer::buffer_ref buf)
+  basic_write_awaitable(Stream& sock, size_t write_bytes, buffer::buffer_ref buf)
     : sock_(sock)
     , bytes_to_write_(write_bytes)
     , write_buf_(buf)
@@ -21,11 +24,11 @@ public:
   }
 
   ///
-  write_awaitable(const write_awaitable&) = delete;
+  basic_write_awaitable(const basic_write_awaitable&) = delete;
   ///
-  write_awaitable& operator=(const write_awaitable&) = delete;
+  basic_write_awaitable& operator=(const basic_write_awaitable&) = delete;
   ///
-  ~write_awaitable() = default;
+  ~basic_write_awaitable() = default;
 
 public: // Awaitable Implementation
   ///
@@ -70,7 +73,7 @@ private:
 
 private:
   ///
-  stream_socket& sock_;
+  Stream& sock_;
 
   ///
   const size_t bytes_to_write_ = 0;
@@ -85,6 +88,9 @@ private:
   std::error_code ec_;
 };
 
+/// Awaitable for writing to a socket
+using write_awaitable = basic_write_awaitable<stream_socket>;
+
 } // END namespace coro_async
 
 #endif
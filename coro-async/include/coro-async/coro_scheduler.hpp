@@ -24,7 +24,9 @@
 #define CORO_ASYNC_coro_scheduler_HPP
 
 #include "coro-async/io_service.hpp"
+#include "coro-async/thread_pool.hpp"
 #include "coro-async/coro/schedule_awaitable.hpp"
+#include "coro-async/coro/offload_awaitable.hpp"
 
 namespace coro_async {
 
@@ -55,10 +57,27 @@ public:
     return { ios_, msecs };
   }
 
+  /// Let the other handlers and the I/O run, then continue.
+  yield_awaitable yield()
+  {
+    return { &ios_ };
+  }
+
+  template <typename Handler>
+  task_completion_awaitable<Handler> wait_for(Handler&& h, priority prio = priority::normal)
+  {
+    return { ios_, std::forward<Handler>(h), prio };
+  }
+
+  /**
+   * Like `wait_for`, but `h` runs on `pool` so that blocking
+   * or CPU heavy work does not stall the io_service.
+   */
   template <typename Handler>
-  task_completion_awaitable<Handler> wait_for(Handler&& h)
+  offload_awaitable<Handler> offload(thread_pool& pool, Handler&& h,
+                                     priority prio = priority::normal)
   {
-    return { ios_, std::forward<Handler>(h) };
+    return { ios_, pool, std::forward<Handler>(h), prio };
   }
 
 private:
@@ -0,0 +1,134 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_CPU_TOPOLOGY_HPP
+#define CORO_ASYNC_CPU_TOPOLOGY_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <system_error>
+
+namespace coro_async {
+
+/**
+ * The CPUs and NUMA nodes of the host, as described by sysfs.
+ *
+ * The topology is read from `<root>/node<N>/cpulist`, `root`
+ * being `/sys/devices/system/node` by default. Pointing it at a
+ * directory laid out the same way gives a fake topology for
+ * testing. A host (or root) without any node directory is treated
+ * as a single node holding the CPUs the process may run on.
+ */
+class cpu_topology
+{
+public:
+  /// The default sysfs root
+  static constexpr const char* sysfs_root = "/sys/devices/system/node";
+
+public:
+  /// Read the topology under `root`.
+  explicit cpu_topology(const std::string& root = sysfs_root);
+
+  /// The topology of the host, read once.
+  static const cpu_topology& system();
+
+public:
+  /// Number of NUMA nodes. Atleast 1.
+  size_t num_nodes() const noexcept
+  {
+    return nodes_.size();
+  }
+
+  /// Number of CPUs over all nodes
+  size_t num_cpus() const noexcept
+  {
+    return num_cpus_;
+  }
+
+  /// CPUs of `node`, ascending
+  const std::vector<int>& cpus_of(size_t node) const noexcept
+  {
+    return nodes_[node].cpus_;
+  }
+
+  /// The sysfs id of `node`
+  int node_id(size_t node) const noexcept
+  {
+    return nodes_[node].id_;
+  }
+
+  /// Index of the node `cpu` belongs to, or -1 if unknown.
+  int node_of(int cpu) const noexcept;
+
+  /// Whether there is more than one node
+  bool is_numa() const noexcept
+  {
+    return nodes_.size() > 1;
+  }
+
+  /**
+   * `n` CPUs to place `n` loops on: all the CPUs of the first
+   * node, then of the next one and so on, wrapping around if
+   * there are more loops than CPUs. Keeps neighbouring shards
+   * on the same socket.
+   */
+  std::vector<int> pick_cpus(size_t n) const;
+
+public:
+  /// Parse a sysfs CPU list such as "0-3,8,10-11".
+  static std::vector<int> parse_cpu_list(const std::string& list);
+
+  /// Pin the calling thread to `cpu`.
+  static void pin_this_thread(int cpu, std::error_code& ec);
+
+  /**
+   * Prefer the pages of `[addr, addr + len)` to be allocated on
+   * the node with sysfs id `node_id`. `addr` must be page aligned.
+   * A no-op (and no error) where NUMA memory policy is
+   * not supported.
+   */
+  static void bind_memory(void* addr, size_t len, int node_id, std::error_code& ec);
+
+private:
+  /// A NUMA node
+  struct node
+  {
+    int id_ = 0;
+    std::vector<int> cpus_;
+  };
+
+  /// Single node fallback
+  void load_flat();
+
+private:
+  /// The nodes with atleast one CPU, by id
+  std::vector<node> nodes_;
+
+  /// Total CPUs
+  size_t num_cpus_ = 0;
+};
+
+} // END namespace coro_async
+
+#include "coro-async/impl/cpu_topology.ipp"
+
+#endif
@@ -0,0 +1,292 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_DATAGRAM_BATCH_HPP
+#define CORO_ASYNC_DATAGRAM_BATCH_HPP
+
+#include <vector>
+#include <cassert>
+#include <cstring>
+#include <cstdint>
+#include <sys/uio.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+
+#include "coro-async/endpoint.hpp"
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+namespace coro_async {
+
+namespace detail {
+template <typename Handler> class recv_batch_op;
+template <typename Handler> class send_batch_op;
+}
+
+/**
+ * A fixed set of datagram slots which are sent or
+ * received with a single `sendmmsg` / `recvmmsg` call.
+ *
+ * All the memory (payload, addresses, ancillary data and
+ * the message headers) is allocated once at construction,
+ * so a batch can be reused for every call without allocating.
+ *
+ * For GSO / GRO make the slots large enough (upto 64 KiB)
+ * to hold many segments:
+ * - Send: a slot pushed with a `segment_size` is split by the
+ *   kernel into datagrams of that size.
+ * - Receive: with GRO enabled on the socket a slot may hold
+ *   several datagrams from the same peer, each of
+ *   `segment_size(i)` bytes (the last one may be shorter).
+ */
+class datagram_batch
+{
+public:
+  /**
+   * Constructor.
+   * \param count - Number of datagrams (messages) per call.
+   * \param slot_size - Max payload per message.
+   */
+  datagram_batch(size_t count, size_t slot_size)
+    : slot_size_(slot_size)
+    , storage_(count * slot_size)
+    , slots_(count)
+    , msgs_(count)
+  {
+    assert (count > 0 && slot_size > 0);
+    for (size_t i = 0; i < count; i++)
+    {
+      slots_[i].iov_.iov_base = &storage_[i * slot_size_];
+      slots_[i].iov_.iov_len = slot_size_;
+    }
+  }
+
+  /// Non copyable (the headers point into the batch)
+  datagram_batch(const datagram_batch&) = delete;
+  datagram_batch& operator=(const datagram_batch&) = delete;
+
+  /// Movable. The vector buffers are stolen, pointers stay valid.
+  datagram_batch(datagram_batch&&) = default;
+  datagram_batch& operator=(datagram_batch&&) = default;
+
+public:
+  /// Max number of messages
+  size_t capacity() const noexcept
+  {
+    return slots_.size();
+  }
+
+  /// Max payload per message
+  size_t slot_size() const noexcept
+  {
+    return slot_size_;
+  }
+
+  /// Messages pushed (send) or received
+  size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  ///
+  bool empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  /// Drop all the messages
+  void clear() noexcept
+  {
+    size_ = 0;
+  }
+
+  /**
+   * Queue a datagram to `to` for sending.
+   * \param segment_size - If non zero, the payload is sent as
+   *        a GSO super datagram split into `segment_size` pieces.
+   * Returns false if the batch is full or the payload too large.
+   */
+  bool push(const void* data, size_t len, const endpoint& to, uint16_t segment_size = 0)
+  {
+    if (!push(data, len, segment_size)) return false;
+
+    auto& s = slots_[size_ - 1];
+    ::memcpy(&s.addr_, to.data(), to.size());
+    msgs_[size_ - 1].msg_hdr.msg_name = &s.addr_;
+    msgs_[size_ - 1].msg_hdr.msg_namelen = to.size();
+    return true;
+  }
+
+  /// Queue a datagram for a connected socket.
+  bool push(const void* data, size_t len, uint16_t segment_size = 0)
+  {
+    if (size_ == capacity() || len > slot_size_) return false;
+
+    auto& s = slots_[size_];
+    ::memcpy(s.iov_.iov_base, data, len);
+    s.iov_.iov_len = len;
+    s.len_ = len;
+    s.segment_size_ = segment_size;
+
+    auto& hdr = msgs_[size_].msg_hdr;
+    ::memset(&hdr, 0, sizeof(hdr));
+    hdr.msg_iov = &s.iov_;
+    hdr.msg_iovlen = 1;
+
+    if (segment_size)
+    {
+      hdr.msg_control = s.control_;
+      hdr.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+      cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+      cmsg->cmsg_level = SOL_UDP;
+      cmsg->cmsg_type = UDP_SEGMENT;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+      ::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+    }
+
+    size_++;
+    return true;
+  }
+
+  /// Payload of message `i`
+  const char* data(size_t i) const noexcept
+  {
+    assert (i < size_);
+    return static_cast<const char*>(slots_[i].iov_.iov_base);
+  }
+
+  /// Payload length of message `i`
+  size_t length(size_t i) const noexcept
+  {
+    assert (i < size_);
+    return slots_[i].len_;
+  }
+
+  /**
+   * Size of each datagram coalesced in message `i` (GRO).
+   * Same as `length(i)` for a plain datagram.
+   */
+  size_t segment_size(size_t i) const noexcept
+  {
+    assert (i < size_);
+    return slots_[i].segment_size_ ? slots_[i].segment_size_ : slots_[i].len_;
+  }
+
+  /// The sender of received message `i`
+  endpoint peer(size_t i) const noexcept
+  {
+    assert (i < size_);
+    return endpoint{reinterpret_cast<const sockaddr*>(&slots_[i].addr_),
+                    msgs_[i].msg_hdr.msg_namelen};
+  }
+
+private:
+  template <typename Handler> friend class detail::recv_batch_op;
+  template <typename Handler> friend class detail::send_batch_op;
+
+  /// Message headers for the system calls
+  mmsghdr* msgs() noexcept
+  {
+    return msgs_.data();
+  }
+
+  /// Point all the slots at their full buffers for receiving
+  void prepare_receive() noexcept
+  {
+    size_ = 0;
+    for (size_t i = 0; i < slots_.size(); i++)
+    {
+      auto& s = slots_[i];
+      s.iov_.iov_len = slot_size_;
+
+      auto& hdr = msgs_[i].msg_hdr;
+      hdr.msg_name = &s.addr_;
+      hdr.msg_namelen = sizeof(s.addr_);
+      hdr.msg_iov = &s.iov_;
+      hdr.msg_iovlen = 1;
+      hdr.msg_control = s.control_;
+      hdr.msg_controllen = sizeof(s.control_);
+      hdr.msg_flags = 0;
+      msgs_[i].msg_len = 0;
+    }
+  }
+
+  /// Pick up the lengths and GRO segment sizes of `n` received messages
+  void finish_receive(size_t n) noexcept
+  {
+    size_ = n;
+    for (size_t i = 0; i < n; i++)
+    {
+      auto& s = slots_[i];
+      auto& hdr = msgs_[i].msg_hdr;
+      s.len_ = msgs_[i].msg_len;
+      s.segment_size_ = 0;
+
+      for (cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg; cmsg = CMSG_NXTHDR(&hdr, cmsg))
+      {
+        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+        {
+          int gso_size = 0;
+          ::memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+          s.segment_size_ = static_cast<uint16_t>(gso_size);
+        }
+      }
+    }
+  }
+
+private:
+  /// Per message state
+  struct slot
+  {
+    /// Points into `storage_`
+    iovec iov_;
+    /// Peer address
+    sockaddr_storage addr_;
+    /// Ancillary data (UDP_SEGMENT / UDP_GRO)
+    alignas(cmsghdr) char control_[CMSG_SPACE(sizeof(int))];
+    /// Payload length
+    size_t len_ = 0;
+    /// GSO / GRO segment size, 0 if none
+    uint16_t segment_size_ = 0;
+  };
+
+  /// Max payload per message
+  size_t slot_size_ = 0;
+  /// The payload memory for all the slots
+  std::vector<char> storage_;
+  /// The slots
+  std::vector<slot> slots_;
+  /// The message headers
+  std::vector<mmsghdr> msgs_;
+  /// Number of valid messages
+  size_t size_ = 0;
+};
+
+} // END namespace coro_async
+
+#endif
@@ -0,0 +1,239 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_DATAGRAM_SOCKET_HPP
+#define CORO_ASYNC_DATAGRAM_SOCKET_HPP
+
+#include "coro-async/endpoint.hpp"
+#include "coro-async/io_service.hpp"
+#include "coro-async/datagram_batch.hpp"
+#include "coro-async/detail/descriptor.hpp"
+#include "coro-async/detail/socket_ops.hpp"
+#include "coro-async/detail/operation_base.hpp"
+#include "coro-async/detail/retire_descriptor.hpp"
+
+namespace coro_async {
+
+/**
+ * A UDP socket handle.
+ * Datagrams are sent and received in batches
+ * (`datagram_batch`) with one system call per batch.
+ */
+class datagram_socket
+{
+private:
+  ///
+  struct implementation
+  {
+    detail::descriptor desc_;
+    //Allocated when called register_descriptor
+    detail::descriptor_state* desc_state_ = nullptr;
+  };
+
+public:
+  /**
+   */
+  datagram_socket(io_executor& io_srv)
+    : reactor_(io_srv.get_reactor())
+    , ios_(io_srv)
+  {
+  }
+
+  /// Move copy constructible
+  datagram_socket(datagram_socket&& other)
+    : reactor_(other.reactor_)
+    , ios_(other.ios_)
+  {
+    impl_.desc_ = std::move(other.impl_.desc_);
+    impl_.desc_state_ = other.impl_.desc_state_;
+    other.impl_.desc_state_ = nullptr;
+  }
+
+  datagram_socket(const datagram_socket&) = delete;
+
+  datagram_socket& operator=(const datagram_socket&) = delete;
+
+  /// Closes the socket. See `close`.
+  ~datagram_socket()
+  {
+    close();
+  }
+
+public:
+  /// Check if socket is created successfully
+  bool is_open() const noexcept
+  {
+    return impl_.desc_.get() != -1;
+  }
+
+  /**
+   * Opens up the socket for the address `family`
+   * (AF_INET or AF_INET6) and registers with reactor.
+   */
+  bool open(int family, std::error_code& ec)
+  {
+    ec.clear();
+
+    int sd = socket(family, SOCK_DGRAM, 0);
+    if (sd == -1)
+    {
+      ec = std::error_code{errno, std::system_category()};
+      return false;
+    }
+
+    impl_.desc_.set(sd);
+
+    int rc = reactor_.register_descriptor(impl_.desc_, &impl_.desc_state_);
+    if (rc != 0)
+    {
+      ec = std::error_code{errno, std::system_category()};
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Close the socket. The pending operations
+   * complete with ECANCELED.
+   */
+  void close()
+  {
+    detail::retire_descriptor(ios_, reactor_, impl_.desc_, impl_.desc_state_);
+    impl_.desc_.close();
+  }
+
+  /// Get the native socket descriptor
+  typename detail::descriptor::descriptor_type
+  get_native_handle() const noexcept
+  {
+    return impl_.desc_.get();
+  }
+
+  /// Binds the socket with (ip:port)
+  void bind(const endpoint& ep, std::error_code& ec)
+  {
+    ec.clear();
+
+    if (!is_open())
+    {
+      if (!open(ep.family(), ec)) return;
+    }
+    detail::posix_socket_ops::bind(get_native_handle(), ep, ec);
+    return;
+  }
+
+  /**
+   * Set the default peer. Only datagrams from `ep` are
+   * received afterwards and messages pushed without an
+   * endpoint are sent to it. Does not block for UDP.
+   */
+  void connect(const endpoint& ep, std::error_code& ec)
+  {
+    ec.clear();
+
+    if (!is_open())
+    {
+      if (!open(ep.family(), ec)) return;
+    }
+    detail::posix_socket_ops::connect(get_native_handle(), ep, ec);
+    return;
+  }
+
+  /// `setsockopt` for integer valued options (e.g. SO_RCVBUF)
+  void set_option(int level, int optname, int value, std::error_code& ec)
+  {
+    detail::posix_socket_ops::set_option(get_native_handle(), level, optname, value, ec);
+  }
+
+  /**
+   * Segment every sent message into datagrams of
+   * `segment_size` bytes in the kernel (UDP GSO).
+   * 0 turns it off. A per message size given to
+   * `datagram_batch::push` takes precedence.
+   */
+  void set_gso_segment(uint16_t segment_size, std::error_code& ec)
+  {
+    set_option(SOL_UDP, UDP_SEGMENT, segment_size, ec);
+  }
+
+  /**
+   * Let the kernel coalesce datagrams from the same flow
+   * into a single received message (UDP GRO).
+   */
+  void set_gro(bool enable, std::error_code& ec)
+  {
+    set_option(SOL_UDP, UDP_GRO, enable ? 1 : 0, ec);
+  }
+
+  /// Busy poll the socket's device queue. See `posix_socket_ops::set_busy_poll`.
+  void set_busy_poll(std::chrono::microseconds usecs, bool prefer, std::error_code& ec)
+  {
+    detail::posix_socket_ops::set_busy_poll(
+        get_native_handle(), static_cast<int>(usecs.count()), prefer, ec);
+  }
+
+  /**
+   */
+  void start_reactor_op(enum reactor_ops r_op, detail::operation_base* op)
+  {
+    reactor_.start_op(impl_.desc_, impl_.desc_state_, r_op, op);
+  }
+
+  ///
+  io_executor& get_io_service() noexcept
+  {
+    return ios_;
+  }
+
+public: // Async Operations
+  /**
+   * Receive upto `batch.capacity()` datagrams in one go.
+   * The batch must exist till the operation finishes.
+   * Handler signature: void(const std::error_code&, size_t num_msgs)
+   */
+  template <typename ReadHandler>
+  void async_receive_batch(datagram_batch& batch, ReadHandler&& rh);
+
+  /**
+   * Send all the datagrams pushed into the batch.
+   * Completes once every message is handed over to the
+   * kernel or on the first error.
+   * The batch must exist till the operation finishes.
+   * Handler signature: void(const std::error_code&, size_t num_msgs_sent)
+   */
+  template <typename WriteHandler>
+  void async_send_batch(datagram_batch& batch, WriteHandler&& wh);
+
+private:
+  ///
+  implementation impl_;
+  ///
+  detail::epoll_reactor& reactor_;
+  ///
+  io_executor& ios_;
+};
+
+} // END namespace coro-async
+
+#include "coro-async/impl/datagram_socket.ipp"
+
+#endif
@@ -0,0 +1,198 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef CORO_ASYNC_CHASE_LEV_DEQUE_HPP
+#define CORO_ASYNC_CHASE_LEV_DEQUE_HPP
+
+#include <memory>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+namespace coro_async {
+namespace detail {
+
+/**
+ * The Chase-Lev work stealing deque.
+ *
+ * The owning thread pushes and pops at the bottom (LIFO),
+ * any other thread steals from the top (FIFO). The memory
+ * orderings follow "Correct and Efficient Work-Stealing for
+ * Weak Memory Models" (Le et al, PPoPP 2013).
+ *
+ * The ring grows when full. The retired rings are kept
+ * around till destruction since a thief may still be
+ * reading from one.
+ *
+ * `T` must be a pointer type. A null result means empty
+ * (or a lost steal race).
+ */
+template <typename T>
+class chase_lev_deque
+{
+public:
+  ///
+  explicit chase_lev_deque(size_t capacity = 256)
+  {
+    size_t cap = 1;
+    while (cap < capacity) cap <<= 1;
+    rings_.emplace_back(new ring{static_cast<int64_t>(cap)});
+    ring_.store(rings_.back().get(), std::memory_order_relaxed);
+  }
+
+  /// Non copyable and non assignable
+  chase_lev_deque(const chase_lev_deque&) = delete;
+  chase_lev_deque& operator=(const chase_lev_deque&) = delete;
+
+public:
+  /// Push at the bottom. Owner thread only.
+  void push(T item)
+  {
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_acquire);
+    ring* r = ring_.load(std::memory_order_relaxed);
+
+    if (b - t > r->capacity_ - 1) r = grow(r, t, b);
+
+    r->put(b, item);
+    // A release store rather than the paper's release fence
+    // followed by a relaxed store. Same cost on x86, and
+    // understood by the thread sanitizer.
+    bottom_.store(b + 1, std::memory_order_release);
+  }
+
+  /// Pop from the bottom. Owner thread only.
+  T pop()
+  {
+    const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    ring* r = ring_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+
+    if (t > b)
+    {
+      // Was empty
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    T item = r->get(b);
+    if (t == b)
+    {
+      // Last element, race against the thieves
+      if (!top_.compare_exchange_strong(t, t + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed))
+      {
+        item = nullptr;
+      }
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  /// Steal from the top. Any thread.
+  T steal()
+  {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t b = bottom_.load(std::memory_order_acquire);
+
+    if (t >= b) return nullptr;
+
+    ring* r = ring_.load(std::memory_order_acquire);
+    T item = r->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1,
+                                      std::memory_order_seq_cst,
+                                      std::memory_order_relaxed))
+    {
+      return nullptr;
+    }
+    return item;
+  }
+
+  /// Approximate number of elements
+  size_t size() const noexcept
+  {
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_t>(b - t) : 0;
+  }
+
+  ///
+  bool empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+private:
+  /// A power of two sized circular array
+  struct ring
+  {
+    explicit ring(int64_t cap)
+      : capacity_(cap)
+      , mask_(cap - 1)
+      , slots_(new std::atomic<T>[cap])
+    {
+    }
+
+    T get(int64_t i) const noexcept
+    {
+      return slots_[i & mask_].load(std::memory_order_relaxed);
+    }
+
+    void put(int64_t i, T item) noexcept
+    {
+      slots_[i & mask_].store(item, std::memory_order_relaxed);
+    }
+
+    int64_t capacity_;
+    int64_t mask_;
+    std::unique_ptr<std::atomic<T>[]> slots_;
+  };
+
+  /// Double the ring. Owner thread only.
+  ring* grow(ring* old, int64_t t, int64_t b)
+  {
+    rings_.emplace_back(new ring{old->capacity_ * 2});
+    ring* r = rings_.back().get();
+    for (int64_t i = t; i < b; i++) r->put(i, old->get(i));
+    ring_.store(r, std::memory_order_release);
+    return r;
+  }
+
+private:
+  /// Steal end
+  alignas(64) std::atomic<int64_t> top_{0};
+  /// Owner end
+  alignas(64) std::atomic<int64_t> bottom_{0};
+  /// The current ring
+  alignas(64) std::atomic<ring*> ring_{nullptr};
+  /// All the rings ever allocated (owner thread only)
+  std::vector<std::unique_ptr<ring>> rings_;
+};
+
+} // END namespace detail
+} // END namespace coro_async
+
+#endif
@@ -0,0 +1,87 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_CONNECT_OP_HPP
+#define CORO_ASYNC_CONNECT_OP_HPP
+
+#include "coro-async/stream_socket.hpp"
+#include "coro-async/detail/socket_ops.hpp"
+#include "coro-async/detail/operation_base.hpp"
+
+namespace coro_async {
+namespace detail {
+
+/**
+ * Handler for completing a non-blocking connect.
+ */
+template <typename Handler>
+class connect_op: public operation_base
+{
+public:
+  /**
+   * Constructor.
+   * \param sock - The socket on which connect is in progress.
+   * \param ch - The completion handler to be invoked on connect.
+   */
+  connect_op(stream_socket& sock, Handler&& ch)
+    : operation_base(connect_op<Handler>::complete)
+    , sock_(sock)
+    , ch_(std::forward<Handler>(ch))
+  {
+  }
+
+  /// Non copyable, non assignable.
+  connect_op(const connect_op&) = delete;
+  connect_op& operator=(const connect_op&) = delete;
+
+public:
+  /// Callback when the socket becomes writable.
+  static void complete(operation_base* op, const std::error_code& ec, size_t bytes_xferred)
+  {
+    auto self = static_cast<connect_op<Handler>*>(op);
+    if (!ec)
+    {
+      // Pick up the result of the connect
+      std::error_code conn_ec{};
+      bool finished = posix_socket_ops::nb_connect(
+                          self->sock_.get_native_handle(), conn_ec);
+      (void)finished;
+
+      self->ch_(conn_ec, 0);
+    }
+    else
+    {
+      self->ch_(ec, 0);
+    }
+    return;
+  }
+
+private:
+  /// The connecting socket
+  stream_socket& sock_;
+  /// The user handler to be executed
+  Handler ch_;
+};
+
+} // END namespace detail
+} // END namespace coro_async
+
+#endif
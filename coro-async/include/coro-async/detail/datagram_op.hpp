@@ -0,0 +1,186 @@
+/*
+  Copyright (c) 2017 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_DATAGRAM_OP_HPP
+#define CORO_ASYNC_DATAGRAM_OP_HPP
+
+#include "coro-async/error_codes.hpp"
+#include "coro-async/datagram_batch.hpp"
+#include "coro-async/datagram_socket.hpp"
+#include "coro-async/detail/socket_ops.hpp"
+#include "coro-async/detail/reactor_ops.hpp"
+#include "coro-async/detail/operation_base.hpp"
+
+namespace coro_async {
+namespace detail {
+
+/**
+ * Handler for receiving a batch of datagrams
+ * with a single `recvmmsg`.
+ */
+template <typename Handler>
+class recv_batch_op: public operation_base
+{
+public:
+  /**
+   * Constructor.
+   * \param sock - The socket to receive from.
+   * \param batch - The batch to be filled.
+   * \param ch - The completion handler.
+   */
+  recv_batch_op(datagram_socket& sock, datagram_batch& batch, Handler&& ch)
+    : operation_base(recv_batch_op<Handler>::complete)
+    , sock_(sock)
+    , batch_(batch)
+    , ch_(std::forward<Handler>(ch))
+  {
+  }
+
+  /// Non copyable, non assignable.
+  recv_batch_op(const recv_batch_op&) = delete;
+  recv_batch_op& operator=(const recv_batch_op&) = delete;
+
+public:
+  /// Callback when the socket is ready for read.
+  static void complete(operation_base* op, const std::error_code& ec, size_t bytes_xferred)
+  {
+    auto self = static_cast<recv_batch_op<Handler>*>(op);
+
+    if (ec)
+    {
+      self->ch_(ec, 0);
+      return;
+    }
+
+    std::error_code read_err{};
+    size_t received = 0;
+
+    self->batch_.prepare_receive();
+    posix_socket_ops::nb_recvmmsg(self->sock_.get_native_handle(),
+                                  self->batch_.msgs(),
+                                  self->batch_.capacity(),
+                                  received,
+                                  read_err);
+
+    if (read_err == error::socket_errc::would_block)
+    {
+      // Spurious wakeup. Wait for the next datagram.
+      self->sock_.start_reactor_op(reactor_ops::read_op, self);
+      return;
+    }
+
+    self->batch_.finish_receive(received);
+    self->ch_(read_err, received);
+  }
+
+private:
+  /// The datagram socket
+  datagram_socket& sock_;
+  /// The batch to be filled
+  datagram_batch& batch_;
+  /// The user handler to be executed
+  Handler ch_;
+};
+
+
+/**
+ * Handler for sending a batch of datagrams with `sendmmsg`.
+ * Keeps going till every message is sent.
+ */
+template <typename Handler>
+class send_batch_op: public operation_base
+{
+public:
+  /**
+   * Constructor.
+   * \param sock - The socket to send on.
+   * \param batch - The messages to be sent.
+   * \param ch - The completion handler.
+   */
+  send_batch_op(datagram_socket& sock, datagram_batch& batch, Handler&& ch)
+    : operation_base(send_batch_op<Handler>::complete)
+    , sock_(sock)
+    , batch_(batch)
+    , ch_(std::forward<Handler>(ch))
+  {
+  }
+
+  /// Non copyable, non assignable.
+  send_batch_op(const send_batch_op&) = delete;
+  send_batch_op& operator=(const send_batch_op&) = delete;
+
+public:
+  /// Callback when the socket is ready to be written to.
+  static void complete(operation_base* op, const std::error_code& ec, size_t bytes_xferred)
+  {
+    auto self = static_cast<send_batch_op<Handler>*>(op);
+
+    if (ec)
+    {
+      self->ch_(ec, self->sent_);
+      return;
+    }
+
+    while (self->sent_ < self->batch_.size())
+    {
+      std::error_code write_err{};
+      size_t sent = 0;
+
+      posix_socket_ops::nb_sendmmsg(self->sock_.get_native_handle(),
+                                    self->batch_.msgs() + self->sent_,
+                                    self->batch_.size() - self->sent_,
+                                    sent,
+                                    write_err);
+
+      if (write_err == error::socket_errc::would_block)
+      {
+        // Socket buffer is full. Continue once it drains.
+        self->sock_.start_reactor_op(reactor_ops::write_op, self);
+        return;
+      }
+
+      if (write_err)
+      {
+        self->ch_(write_err, self->sent_);
+        return;
+      }
+
+      self->sent_ += sent;
+    }
+
+    self->ch_(std::error_code{}, self->sent_);
+  }
+
+private:
+  /// The datagram socket
+  datagram_socket& sock_;
+  /// The messages to be sent
+  datagram_batch& batch_;
+  /// Messages sent so far
+  size_t sent_ = 0;
+  /// The user handler to be executed
+  Handler ch_;
+};
+
+} // END namespace detail
+} // END namespace coro_async
+
+#endif
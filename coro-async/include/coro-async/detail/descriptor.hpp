@@ -69,7 +69,7 @@ public: // 'tors
   /// Move assignment.
   descriptor& operator=(descriptor&& other)
   {
-    if (fd_ != -1) close(fd_);
+    if (fd_ != -1) ::close(fd_);
     fd_ = other.fd_;
     other.fd_ = -1;
     make_fd_non_blocking();
@@ -82,7 +82,7 @@ public: // 'tors
   /// Close the descriptor
   ~descriptor()
   {
-    if (fd_ != -1) close(fd_);
+    if (fd_ != -1) ::close(fd_);
   }
 
 public: // Public APIs
@@ -100,11 +100,32 @@ public: // Public APIs
    */
   void set(descriptor_type fd) noexcept
   {
-    if (fd_ != -1) close(fd_);
+    if (fd_ != -1) ::close(fd_);
     fd_ = fd;
     make_fd_non_blocking();
   }
 
+  /**
+   * Give up the ownership of the descriptor
+   * without closing it.
+   */
+  descriptor_type release() noexcept
+  {
+    auto fd = fd_;
+    fd_ = -1;
+    return fd;
+  }
+
+  /**
+   * Close the underlying descriptor now rather than
+   * on destruction.
+   */
+  void close() noexcept
+  {
+    if (fd_ != -1) ::close(fd_);
+    fd_ = -1;
+  }
+
 private:
   /// Make the descriptor non-blocking.
   void make_fd_non_blocking()
@@ -197,6 +218,12 @@ public:
     return op;
   }
 
+  /// Are any operations waiting on the descriptor.
+  bool has_pending_ops() const noexcept
+  {
+    return !rd_op_queue_.empty() || !wr_op_queue_.empty() || !co_op_queue_.empty();
+  }
+
   /// Get reference to the read operation queue.
   op_queue& rd_q() noexcept { return rd_op_queue_; }
 
@@ -210,6 +237,9 @@ public:
   /// Registered epoll events
   uint32_t registered_events_ = 0;
 
+  /// Run the ready operations before the ones of normal descriptors
+  bool high_priority_ = false;
+
 private:
   /// The associated descriptor
   descriptor& desc_;
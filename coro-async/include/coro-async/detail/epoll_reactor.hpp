@@ -23,6 +23,9 @@
 #ifndef CORO_ASYNC_EPOLL_REACTOR
 #define CORO_ASYNC_EPOLL_REACTOR
 
+#include <chrono>
+#include <cstdint>
+#include <system_error>
 #include "coro-async/detail/epoll.hpp"
 #include "coro-async/detail/descriptor.hpp"
 #include "coro-async/detail/reactor_ops.hpp"
@@ -38,14 +41,18 @@ namespace detail {
 class epoll_reactor
 {
 public:
-  /// Default constructor.
-  explicit epoll_reactor() = default;
+  /**
+   * Default constructor.
+   * Throws `std::system_error` if the interrupter
+   * eventfd cannot be created.
+   */
+  explicit epoll_reactor();
 
   /// non copyable non assignable
   epoll_reactor(const epoll_reactor&) = delete;
   epoll_reactor& operator=(const epoll_reactor&) = delete;
 
-  ~epoll_reactor() = default;
+  ~epoll_reactor();
 
 public:
   /**
@@ -70,17 +77,64 @@ public:
    */
   int register_descriptor(descriptor& d, descriptor_state** dstate);
 
+  /**
+   * Removes a descriptor from the event system, eg. to
+   * register it with another reactor. The descriptor state
+   * is left to the caller to free.
+   *
+   * \param d - The descriptor to be removed from epoll.
+   */
+  int deregister_descriptor(descriptor& d);
+
   /**
    * Gather the ready events from the registered
-   * descriptor set.
+   * descriptor set and run the ready operations.
    *
    * \param timeout - The timeout to be used for the epoll_wait call.
+   * \param max_events - Upper bound on the descriptors handled.
+   * \param waited - If not null, set to the time spent blocked in
+   *                 `epoll_wait`, which excludes the time taken by
+   *                 the operations invoked.
+   * \returns The number of operations invoked.
+   */
+  size_t run(int timeout, size_t max_events = max_events_per_run,
+             std::chrono::nanoseconds* waited = nullptr);
+
+  /**
+   * The epoll descriptor. It turns readable when any
+   * registered descriptor is ready, which allows nesting
+   * the reactor inside another event loop.
    */
-  void run(int timeout);
+  int native_handle() const noexcept
+  {
+    return epoll_.get();
+  }
+
+  /**
+   * Let `epoll_wait` busy poll the NIC queues of the registered
+   * sockets for upto `usecs` before sleeping (EPIOCSPARAMS,
+   * Linux 6.9+). Fails with ENOTTY on older kernels.
+   * \param budget - Packets per busy poll attempt.
+   * \param prefer - Prefer busy polling over interrupts.
+   */
+  void set_busy_poll(uint32_t usecs, uint16_t budget, bool prefer, std::error_code& ec);
+
+  /**
+   * Wake up a thread blocked in `run`.
+   * Thread safe.
+   */
+  void interrupt() noexcept;
+
+public:
+  /// Max events gathered by one `run`
+  static constexpr size_t max_events_per_run = 128;
 
 private:
   /// The epoll descriptor.
   Epoll epoll_;
+
+  /// eventfd written by `interrupt`
+  int interrupter_ = -1;
 };
 
 } // END namespace detail
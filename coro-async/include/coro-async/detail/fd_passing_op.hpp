@@ -0,0 +1,193 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_FD_PASSING_OP_HPP
+#define CORO_ASYNC_FD_PASSING_OP_HPP
+
+#include <array>
+#include <algorithm>
+
+#include "coro-async/buffers.hpp"
+#include "coro-async/buffer_ref.hpp"
+#include "coro-async/stream_socket.hpp"
+#include "coro-async/detail/socket_ops.hpp"
+#include "coro-async/detail/operation_base.hpp"
+
+namespace coro_async {
+namespace detail {
+
+/**
+ * Handler for sending descriptors (SCM_RIGHTS) over
+ * a unix domain socket along with some data.
+ */
+template <typename Handler>
+class send_fds_op: public operation_base
+{
+public:
+  /**
+   * Constructor.
+   * \param sock - The unix domain socket to send on.
+   * \param buf - The data carrying the descriptors. Must not be empty.
+   * \param fds - The descriptors. Copied, need not outlive the op.
+   * \param nfds - Number of descriptors (atmost `max_passed_fds`).
+   * \param ch - The completion handler.
+   */
+  template <typename Buffer>
+  send_fds_op(stream_socket& sock, const Buffer& buf,
+              const int* fds, size_t nfds, Handler&& ch)
+    : operation_base(send_fds_op<Handler>::complete)
+    , sock_(sock)
+    , buffer_(buf)
+    , nfds_(nfds)
+    , ch_(std::forward<Handler>(ch))
+  {
+    assert (nfds <= posix_socket_ops::max_passed_fds);
+    std::copy(fds, fds + nfds, fds_.begin());
+  }
+
+  /// Non copyable, non assignable.
+  send_fds_op(const send_fds_op&) = delete;
+  send_fds_op& operator=(const send_fds_op&) = delete;
+
+public:
+  /// Callback when the socket is ready to be written to.
+  static void complete(operation_base* op, const std::error_code& ec, size_t bytes_xferred)
+  {
+    auto self = static_cast<send_fds_op<Handler>*>(op);
+
+    if (!ec)
+    {
+      std::error_code write_err{};
+      size_t bytes_wrote = 0;
+
+      bool finished = posix_socket_ops::nb_send_fds(
+                                self->sock_.get_native_handle(),
+                                self->buffer_,
+                                self->fds_.data(),
+                                self->nfds_,
+                                bytes_wrote,
+                                write_err);
+      (void)finished;
+
+      self->ch_(write_err, bytes_wrote);
+    }
+    else
+    {
+      self->ch_(ec, 0);
+    }
+  }
+
+private:
+  /// The unix domain socket
+  stream_socket& sock_;
+  /// The data buffer
+  const buffer::buffer_ref buffer_;
+  /// The descriptors to be sent
+  std::array<int, posix_socket_ops::max_passed_fds> fds_;
+  /// Number of valid entries in `fds_`
+  size_t nfds_ = 0;
+  /// The user handler to be executed
+  Handler ch_;
+};
+
+
+/**
+ * Handler for receiving data along with descriptors
+ * (SCM_RIGHTS) from a unix domain socket.
+ * The handler signature is:
+ *   void(const std::error_code&, size_t bytes_read, size_t nfds)
+ */
+template <typename Handler>
+class recv_fds_op: public operation_base
+{
+public:
+  /**
+   * Constructor.
+   * \param sock - The unix domain socket to receive from.
+   * \param buf - The buffer into which data is read.
+   * \param fds - Where the received descriptors are stored.
+   *              Must exist till the op completes.
+   * \param max_fds - Capacity of `fds`.
+   * \param ch - The completion handler.
+   */
+  template <typename Buffer>
+  recv_fds_op(stream_socket& sock, const Buffer& buf,
+              int* fds, size_t max_fds, Handler&& ch)
+    : operation_base(recv_fds_op<Handler>::complete)
+    , sock_(sock)
+    , buffer_(buf)
+    , fds_(fds)
+    , max_fds_(max_fds)
+    , ch_(std::forward<Handler>(ch))
+  {
+  }
+
+  /// Non copyable, non assignable.
+  recv_fds_op(const recv_fds_op&) = delete;
+  recv_fds_op& operator=(const recv_fds_op&) = delete;
+
+public:
+  /// Callback when the socket is ready for read.
+  static void complete(operation_base* op, const std::error_code& ec, size_t bytes_xferred)
+  {
+    auto self = static_cast<recv_fds_op<Handler>*>(op);
+
+    if (!ec)
+    {
+      std::error_code read_err{};
+      size_t bytes_read = 0;
+      size_t nfds = 0;
+
+      bool finished = posix_socket_ops::nb_recv_fds(
+                                self->sock_.get_native_handle(),
+                                self->buffer_,
+                                self->fds_,
+                                self->max_fds_,
+                                bytes_read,
+                                nfds,
+                                read_err);
+      (void)finished;
+
+      self->ch_(read_err, bytes_read, nfds);
+    }
+    else
+    {
+      self->ch_(ec, 0, 0);
+    }
+  }
+
+private:
+  /// The unix domain socket
+  stream_socket& sock_;
+  /// The read buffer
+  buffer::buffer_ref buffer_;
+  /// The received descriptors
+  int* fds_ = nullptr;
+  /// Capacity of `fds_`
+  size_t max_fds_ = 0;
+  /// The user handler to be executed
+  Handler ch_;
+};
+
+} // END namespace detail
+} // END namespace coro_async
+
+#endif
@@ -1,12 +1,83 @@
 #ifndef CORO_ASYNC_EPOLL_REACTOR_IPP
 #define CORO_ASYNC_EPOLL_REACTOR_IPP
 
+#include <cerrno>
 #include <cassert>
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/eventfd.h>
 #include "coro-async/detail/reactor_ops.hpp"
 
 namespace coro_async {
 namespace detail {
 
+namespace {
+
+/// `struct epoll_params` of <linux/eventpoll.h>, missing in older headers
+struct epoll_busy_poll_params
+{
+  uint32_t busy_poll_usecs;
+  uint16_t busy_poll_budget;
+  uint8_t prefer_busy_poll;
+  uint8_t pad;
+};
+
+#ifdef EPIOCSPARAMS
+constexpr unsigned long epoll_set_params = EPIOCSPARAMS;
+#else
+constexpr unsigned long epoll_set_params = _IOW(0x8A, 0x01, epoll_busy_poll_params);
+#endif
+
+} // END anonymous namespace
+
+epoll_reactor::epoll_reactor()
+{
+  interrupter_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (interrupter_ == -1)
+  {
+    std::error_code ec = std::error_code{errno, std::system_category()};
+    throw std::system_error{ec, std::strerror(errno)};
+  }
+
+  // Identified in `run` by the address of `interrupter_`
+  epoll_event ev = {0, { 0 }};
+  ev.events = EPOLLIN | EPOLLET;
+  ev.data.ptr = &interrupter_;
+
+  std::error_code ec{};
+  epoll_.add_descriptor(interrupter_, &ev, ec);
+  if (ec)
+  {
+    ::close(interrupter_);
+    throw std::system_error{ec};
+  }
+}
+
+epoll_reactor::~epoll_reactor()
+{
+  ::close(interrupter_);
+}
+
+void epoll_reactor::interrupt() noexcept
+{
+  uint64_t one = 1;
+  ssize_t rc = ::write(interrupter_, &one, sizeof(one));
+  (void)rc;
+}
+
+void epoll_reactor::set_busy_poll(
+    uint32_t usecs, uint16_t budget, bool prefer, std::error_code& ec)
+{
+  ec.clear();
+
+  epoll_busy_poll_params params = { usecs, budget, static_cast<uint8_t>(prefer ? 1 : 0), 0 };
+  if (::ioctl(epoll_.get(), epoll_set_params, &params) != 0)
+  {
+    ec = std::error_code{errno, std::system_category()};
+  }
+}
+
 int epoll_reactor::start_op(
     descriptor& d,
     descriptor_state* dstate,
@@ -76,6 +147,16 @@ int epoll_reactor::start_op(
       assert (0 && "Code not reached");
   };
 
+  // Keep the interest of the other operations still pending
+  // on the descriptor, else re-arming for a read would drop
+  // a queued write (and vice versa).
+  ev.events |= EPOLLIN;
+  if (!dstate->is_op_queue_empty(dstate->wr_q()) ||
+      !dstate->is_op_queue_empty(dstate->connect_q()))
+  {
+    ev.events |= EPOLLOUT;
+  }
+
   std::error_code ec{};
   ev.data.ptr = dstate;
   epoll_.modify_descriptor(d.get(), &ev, ec);
@@ -108,62 +189,121 @@ int epoll_reactor::register_descriptor(descriptor& d, descriptor_state** dstate)
   return ec ? ec.value() : 0;
 }
 
-void epoll_reactor::run(int timeout)
+int epoll_reactor::deregister_descriptor(descriptor& d)
+{
+  assert (d.get() != -1);
+
+  epoll_event ev = {0, { 0 }};
+  std::error_code ec{};
+  epoll_.delete_descriptor(d.get(), &ev, ec);
+
+  return ec ? ec.value() : 0;
+}
+
+size_t epoll_reactor::run(int timeout, size_t max_events, std::chrono::nanoseconds* waited)
 {
-  epoll_event events[128];
+  epoll_event events[max_events_per_run];
+  if (max_events == 0) return 0;
+  if (max_events > max_events_per_run) max_events = max_events_per_run;
+
+  std::chrono::steady_clock::time_point start{};
+  if (waited) start = std::chrono::steady_clock::now();
+
   int num_events = epoll_wait(epoll_.get(),
                               &events[0],
-                              sizeof(events)/sizeof(epoll_event),
+                              static_cast<int>(max_events),
                               timeout);
 
+  if (waited)
+  {
+    *waited = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - start);
+  }
+  size_t num_invoked = 0;
+
+  // The events of high priority descriptors are run first. The
+  // order is decided before any operation runs, as a completion
+  // handler may free up the state of another descriptor.
+  int order[max_events_per_run];
+  int num_high = 0;
   for (int i = 0; i < num_events; i++)
   {
     void* ptr = events[i].data.ptr;
+    if (ptr != &interrupter_ &&
+        static_cast<descriptor_state*>(ptr)->high_priority_)
+    {
+      order[num_high++] = i;
+    }
+  }
+  if (num_high)
+  {
+    int next = num_high;
+    for (int i = 0; i < num_events; i++)
+    {
+      void* ptr = events[i].data.ptr;
+      if (ptr == &interrupter_ ||
+          !static_cast<descriptor_state*>(ptr)->high_priority_)
+      {
+        order[next++] = i;
+      }
+    }
+  }
+
+  for (int k = 0; k < num_events; k++)
+  {
+    epoll_event& event = events[num_high ? order[k] : k];
+
+    void* ptr = event.data.ptr;
+    if (ptr == &interrupter_)
+    {
+      uint64_t count = 0;
+      ssize_t rc = ::read(interrupter_, &count, sizeof(count));
+      (void)rc;
+      continue;
+    }
     auto dstate = static_cast<descriptor_state*>(ptr);
-    std::cout << "dstate ptr: " << (intptr_t)dstate << std::endl;
 
-    if ((dstate->registered_events_ | EPOLLOUT))
+    // Only run the operations for which the descriptor
+    // is actually ready.
+    const uint32_t ready = event.events;
+
+    // The ready operations are dequeued before any of them
+    // is invoked, as a completion handler may close the socket
+    // and free up the descriptor state.
+    operation_base* ready_ops[3] = { nullptr, nullptr, nullptr };
+    int num_ops = 0;
+
+    if (ready & (EPOLLOUT | EPOLLERR | EPOLLHUP))
     {
-      if (dstate->connect_q().size())
+      if (!dstate->is_op_queue_empty(dstate->connect_q()))
       {
-        auto& q = dstate->connect_q();
-        auto& cb = q.front();
-
-        std::error_code ec{};
-        cb->call(cb, ec, 0);
-        // Remove the callback
-        q.pop();
+        ready_ops[num_ops++] = dstate->pop_front_op(dstate->connect_q());
       }
 
       // Check for write tasks
-      if (dstate->wr_q().size())
+      if (!dstate->is_op_queue_empty(dstate->wr_q()))
       {
-        auto& q = dstate->wr_q();
-        auto& cb = q.front();
-
-        std::error_code ec{};
-        cb->call(cb, ec, 0);
-        // Remove the callback
-        q.pop();
+        ready_ops[num_ops++] = dstate->pop_front_op(dstate->wr_q());
       }
     }
 
-    if ((dstate->registered_events_ | EPOLLIN))
+    if (ready & (EPOLLIN | EPOLLPRI | EPOLLERR | EPOLLHUP))
     {
-      if (dstate->rd_q().size())
+      if (!dstate->is_op_queue_empty(dstate->rd_q()))
       {
-        auto& q = dstate->rd_q();
-        auto& cb = q.front();
-
-        std::error_code ec{};
-        cb->call(cb, ec, 0);
-        // Remove the callback
-        q.pop();
+        ready_ops[num_ops++] = dstate->pop_front_op(dstate->rd_q());
       }
     }
+
+    for (int j = 0; j < num_ops; j++)
+    {
+      std::error_code ec{};
+      ready_ops[j]->call(ready_ops[j], ec, 0);
+    }
+    num_invoked += num_ops;
   }
 
-  return;
+  return num_invoked;
 }
 
 } // END namespace detail
@@ -2,81 +2,493 @@
 #define CORO_ASYNC_SCHEDULER_IPP
 
 #include <cassert>
+#include <algorithm>
 
 namespace coro_async {
 namespace detail {
 
-scheduler::scheduler()
+template <typename Threading>
+basic_scheduler<Threading>::basic_scheduler()
 {
 }
 
+template <typename Threading>
+basic_scheduler<Threading>::basic_scheduler(scheduling_policy policy, size_t concurrency)
+  : policy_(policy)
+{
+  if (policy_ == scheduling_policy::work_stealing)
+  {
+    num_workers_ = concurrency ? concurrency : 1;
+    workers_.reset(new worker[num_workers_]);
+  }
+}
+
+template <typename Threading>
+basic_scheduler<Threading>::worker_scope::worker_scope(basic_scheduler& sched)
+  : prev_(current_)
+{
+  // Already running this scheduler up the stack
+  if (sched.this_worker()) return;
+
+  for (size_t i = 0; i < sched.num_workers_; i++)
+  {
+    auto& w = sched.workers_[i];
+    if (!w.claimed_.exchange(true, std::memory_order_acquire))
+    {
+      claimed_ = &w;
+      current_ = { &sched, &w };
+      return;
+    }
+  }
+}
+
+template <typename Threading>
+basic_scheduler<Threading>::worker_scope::~worker_scope()
+{
+  if (!claimed_) return;
+  // Whatever is left in the deque is either stolen or
+  // picked up by the next thread claiming the slot.
+  current_ = prev_;
+  claimed_->claimed_.store(false, std::memory_order_release);
+}
+
+template <typename Threading>
 template <typename Handler>
-void scheduler::post(scheduler_op<Handler>* op)
+void basic_scheduler<Threading>::post(scheduler_op<Handler>* op, priority prio)
+{
+  post_op(op, prio);
+}
+
+template <typename Threading>
+void basic_scheduler<Threading>::post_op(operation_base* op, priority prio)
+{
+  if (prio == priority::high)
+  {
+    std::lock_guard<mutex_type> guard{op_q_lock_};
+    hi_q_.push(op);
+    hi_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+  else if (auto w = this_worker())
+  {
+    w->queue_.push(op);
+    // Pairs with `wait_for_work` counting itself before it checks
+    // the deques: either it sees the op or this sees the waiter.
+    Threading::fence();
+    if (idle_waiters_.load(std::memory_order_relaxed))
+    {
+      // Not pushed under the lock: the waiter may not have
+      // blocked yet, the notify below would then be lost.
+      std::lock_guard<mutex_type> guard{op_q_lock_};
+    }
+  }
+  else
+  {
+    std::lock_guard<mutex_type> guard{op_q_lock_};
+    op_q_.push(op);
+  }
+
+  wake();
+
+  if (idle_waiters_.load(std::memory_order_relaxed))
+  {
+    wait_event_.notify_one();
+  }
+}
+
+template <typename Threading>
+void basic_scheduler<Threading>::defer_op(operation_base* op)
 {
-  std::lock_guard<std::mutex> guard{op_q_lock_};
-  op_q_.push(op);
+  {
+    std::lock_guard<mutex_type> guard{op_q_lock_};
+    deferred_q_.push(op);
+    deferred_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  wake();
+
+  if (idle_waiters_.load(std::memory_order_relaxed))
+  {
+    wait_event_.notify_one();
+  }
 }
 
+template <typename Threading>
+void basic_scheduler<Threading>::wake() noexcept
+{
+  // Nothing can post while the only thread is blocked
+  if constexpr (!Threading::concurrent) return;
+
+  // Pairs with the fence in `do_run_once`: either the sleeper
+  // sees the work, or the waker sees the sleeper.
+  Threading::fence();
+  if (reactor_sleeping_.load(std::memory_order_relaxed) &&
+      reactor_sleeping_.exchange(false, std::memory_order_relaxed))
+  {
+    reactor_.interrupt();
+  }
+}
+
+template <typename Threading>
+void basic_scheduler<Threading>::add_loop_hook(const loop_hook* hook)
+{
+  hooks_.push_back(hook);
+}
+
+template <typename Threading>
+void basic_scheduler<Threading>::remove_loop_hook(const loop_hook* hook)
+{
+  hooks_.erase(std::remove(hooks_.begin(), hooks_.end(), hook), hooks_.end());
+}
+
+template <typename Threading>
 template <typename T>
-void scheduler::schedule_after(std::chrono::seconds secs, T&& cb)
+void basic_scheduler<Threading>::schedule_after(std::chrono::seconds secs, T&& cb)
 {
-  std::lock_guard<std::mutex> guard{timer_q_lock_};
+  std::lock_guard<mutex_type> guard{timer_q_lock_};
   timers_.add(secs, std::forward<T>(cb));
 }
 
+template <typename Threading>
 template <typename T>
-void scheduler::schedule_after(std::chrono::milliseconds msecs, T&& cb)
+void basic_scheduler<Threading>::schedule_after(std::chrono::milliseconds msecs, T&& cb)
 {
+  std::lock_guard<mutex_type> guard{timer_q_lock_};
   timers_.add(msecs, std::forward<T>(cb));
 }
 
-void scheduler::run(std::error_code& ec)
+template <typename Threading>
+size_t basic_scheduler<Threading>::run(std::error_code& ec)
 {
-  while (true)
+  worker_scope scope{*this};
+  size_t n = 0;
+  while (!stopped())
   {
-    //std::lock_guard<std::mutex> guard{op_q_lock_};
-    do_run_locked(ec);
+    n += do_run_once(reactor_tick_ms, unbounded, ec);
   }
+  return n;
 }
 
-void scheduler::do_run_locked(const std::error_code& ec)
+template <typename Threading>
+size_t basic_scheduler<Threading>::run_one(std::error_code& ec)
 {
-  // Run the reactor
-  reactor_.run(2);
+  worker_scope scope{*this};
+  while (!stopped())
+  {
+    size_t n = do_run_once(reactor_tick_ms, 1, ec);
+    if (n) return n;
+  }
+  return 0;
+}
+
+template <typename Threading>
+size_t basic_scheduler<Threading>::poll(std::error_code& ec)
+{
+  worker_scope scope{*this};
+  return do_run_once(0, unbounded, ec);
+}
 
-  while (!op_q_.is_empty())
+template <typename Threading>
+size_t basic_scheduler<Threading>::poll_one(std::error_code& ec)
+{
+  worker_scope scope{*this};
+  return do_run_once(0, 1, ec);
+}
+
+template <typename Threading>
+template <typename Rep, typename Period>
+size_t basic_scheduler<Threading>::run_for(const std::chrono::duration<Rep, Period>& dur, std::error_code& ec)
+{
+  worker_scope scope{*this};
+  using namespace std::chrono;
+  const auto deadline = steady_clock::now() + duration_cast<steady_clock::duration>(dur);
+  size_t n = 0;
+
+  while (!stopped())
   {
-    op_q_lock_.lock();
-    auto op = op_q_.pop();
-    op_q_lock_.unlock();
+    const auto left = duration_cast<milliseconds>(deadline - steady_clock::now());
+    if (left.count() < 0) break;
 
-    // do the call to handler
-    op->call(op, ec, 0);
+    const int timeout = std::min<int>(reactor_tick_ms, left.count());
+    n += do_run_once(timeout, unbounded, ec);
+  }
+  return n;
+}
+
+template <typename Threading>
+operation_base* basic_scheduler<Threading>::next_op()
+{
+  // High priority first, except that after a run of them one
+  // normal operation (if any) is let through.
+  if (hi_count_.load(std::memory_order_relaxed))
+  {
+    std::lock_guard<mutex_type> guard{op_q_lock_};
+    if (!hi_q_.is_empty() && hi_streak_ < max_high_streak)
+    {
+      auto op = hi_q_.pop();
+      hi_count_.fetch_sub(1, std::memory_order_relaxed);
+      // The run ends once the queue is drained
+      hi_streak_ = hi_q_.is_empty() ? 0 : hi_streak_ + 1;
+      return op;
+    }
+    hi_streak_ = 0;
+  }
+
+  auto self = this_worker();
+  if (self)
+  {
+    if (auto op = self->queue_.pop()) return op;
+  }
+
+  {
+    std::lock_guard<mutex_type> guard{op_q_lock_};
+    if (!op_q_.is_empty()) return op_q_.pop();
+
+    // No normal work to let through
+    if (!hi_q_.is_empty())
+    {
+      hi_count_.fetch_sub(1, std::memory_order_relaxed);
+      return hi_q_.pop();
+    }
+  }
+
+  if (policy_ == scheduling_policy::work_stealing)
+  {
+    return steal(self);
+  }
+  return nullptr;
+}
+
+template <typename Threading>
+operation_base* basic_scheduler<Threading>::steal(worker* self)
+{
+  // Start from a different victim on every call so
+  // that the thieves do not all hit the same deque.
+  static thread_local size_t start = 0;
+  start++;
+
+  for (size_t i = 0; i < num_workers_; i++)
+  {
+    auto& victim = workers_[(start + i) % num_workers_];
+    if (&victim == self) continue;
+    if (auto op = victim.queue_.steal()) return op;
+  }
+  return nullptr;
+}
+
+template <typename Threading>
+bool basic_scheduler<Threading>::has_queued_work()
+{
+  if (hi_count_.load(std::memory_order_relaxed)) return true;
+  if (deferred_count_.load(std::memory_order_relaxed)) return true;
+
+  {
+    std::lock_guard<mutex_type> guard{op_q_lock_};
+    if (!op_q_.is_empty()) return true;
+  }
+
+  return has_deque_work();
+}
+
+template <typename Threading>
+bool basic_scheduler<Threading>::has_deque_work()
+{
+  for (size_t i = 0; i < num_workers_; i++)
+  {
+    if (!workers_[i].queue_.empty()) return true;
+  }
+
+  return false;
+}
+
+template <typename Threading>
+bool basic_scheduler<Threading>::hooks_pending()
+{
+  for (auto hook : hooks_)
+  {
+    if (hook->pending_(hook->ctx_)) return true;
   }
-  
+  return false;
+}
+
+template <typename Threading>
+void basic_scheduler<Threading>::wait_for_work(int timeout)
+{
+  std::unique_lock<mutex_type> lk{op_q_lock_};
+  // Counted before the check: the worker deques are pushed to
+  // without the lock (see `post_op`).
+  idle_waiters_.fetch_add(1, std::memory_order_seq_cst);
+  if (!op_q_.is_empty() || !hi_q_.is_empty() || !deferred_q_.is_empty() ||
+      has_deque_work())
   {
-    std::lock_guard<std::mutex> guard{timer_q_lock_};
-    auto curr_time = timers_.current_time();
+    idle_waiters_.fetch_sub(1, std::memory_order_relaxed);
+    return;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  wait_event_.wait_for(lk, std::chrono::milliseconds(timeout));
+  add_idle_time(start);
+  idle_waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
 
-    while (timers_.size())
+template <typename Threading>
+void basic_scheduler<Threading>::add_idle_time(std::chrono::steady_clock::time_point start) noexcept
+{
+  const auto idle = std::chrono::steady_clock::now() - start;
+  idle_ns_.fetch_add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(idle).count(),
+      std::memory_order_relaxed);
+}
+
+template <typename Threading>
+bool basic_scheduler<Threading>::spin(size_t max_events, size_t& n)
+{
+  const auto start = std::chrono::steady_clock::now();
+  auto now = start;
+  bool found = false;
+
+  while (true)
+  {
+    // The handlers run by the reactor are not spin time
+    const auto polled_at = now;
+    const size_t k = reactor_.run(0, max_events);
+    n += k;
+
+    if (k > 0 || has_queued_work() || hooks_pending() || stopped())
     {
-      // TODO: Copy ?
-      auto element = timers_.peek();
-      if (curr_time >= element.first)
+      found = true;
+      now = polled_at;
+      break;
+    }
+
+    now = std::chrono::steady_clock::now();
+    if (now - start >= spin_budget_) break;
+  }
+
+  const auto spun = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+  spin_ns_.fetch_add(spun, std::memory_order_relaxed);
+  idle_ns_.fetch_add(spun, std::memory_order_relaxed);
+  if (found) spin_hits_.fetch_add(1, std::memory_order_relaxed);
+
+  return found;
+}
+
+template <typename Threading>
+loop_stats basic_scheduler<Threading>::stats() const noexcept
+{
+  loop_stats st;
+  st.uptime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - created_);
+  st.idle_time = std::chrono::nanoseconds{idle_ns_.load(std::memory_order_relaxed)};
+  st.spin_time = std::chrono::nanoseconds{spin_ns_.load(std::memory_order_relaxed)};
+  st.spin_hits = spin_hits_.load(std::memory_order_relaxed);
+  st.sleeps = sleeps_.load(std::memory_order_relaxed);
+  return st;
+}
+
+template <typename Threading>
+size_t basic_scheduler<Threading>::do_run_once(int timeout, size_t max_handlers, const std::error_code& ec)
+{
+  size_t n = 0;
+
+  // What was deferred in the last iteration runs in this one,
+  // behind everything queued so far.
+  if (deferred_count_.load(std::memory_order_relaxed))
+  {
+    std::lock_guard<mutex_type> guard{op_q_lock_};
+    deferred_count_.store(0, std::memory_order_relaxed);
+    op_q_.push(deferred_q_);
+  }
+
+  // Run the reactor. Only one thread waits in it, the
+  // others keep running (and stealing) the posted operations.
+  bool polled = false;
+  if (reactor_lock_.try_lock())
+  {
+    const size_t max_events = max_handlers == unbounded
+                                ? epoll_reactor::max_events_per_run
+                                : max_handlers;
+
+    // Spin before sleeping. The events it found were run already.
+    const bool spun_ready = timeout > 0 && spin_budget_.count() > 0 &&
+                            spin(max_events, n);
+    if (spun_ready) timeout = 0;
+
+    // A post made while blocked in the reactor interrupts it
+    if (timeout > 0)
+    {
+      reactor_sleeping_.store(true, std::memory_order_relaxed);
+      Threading::fence();
+    }
+
+    // Do not block in the reactor when there is work queued up
+    if (has_queued_work() || hooks_pending()) timeout = 0;
+
+    if (!spun_ready)
+    {
+      // Only a blocking wait counts as idle, not the
+      // completions the reactor runs once it wakes up.
+      std::chrono::nanoseconds waited{0};
+      if (timeout > 0)
       {
-        (element.second)();
-        timers_.remove();
+        sleeps_.fetch_add(1, std::memory_order_relaxed);
+        n += reactor_.run(timeout, max_events, &waited);
+        idle_ns_.fetch_add(waited.count(), std::memory_order_relaxed);
       }
       else
       {
-        break;
+        n += reactor_.run(timeout, max_events);
       }
     }
-  } // timer scope end
+    reactor_sleeping_.store(false, std::memory_order_relaxed);
+
+    // Under the reactor lock, so that the hooks
+    // never run concurrently.
+    for (auto hook : hooks_)
+    {
+      n += hook->poll_(hook->ctx_);
+    }
+    reactor_lock_.unlock();
+    polled = true;
+  }
+  else if (has_queued_work())
+  {
+    timeout = 0;
+  }
+
+  // Bounded, so that handlers posting more handlers do
+  // not keep the reactor and the timers from running.
+  size_t budget = handler_budget_;
+  while (n < max_handlers && budget--)
+  {
+    auto op = next_op();
+    if (!op) break;
+
+    // do the call to handler
+    op->call(op, ec, 0);
+    n++;
+  }
+
+  auto curr_time = timers_.current_time();
+  while (n < max_handlers)
+  {
+    unique_function<void()> cb;
+    {
+      std::lock_guard<mutex_type> guard{timer_q_lock_};
+      if (!timers_.size() || curr_time < timers_.peek().first) break;
+
+      cb = std::move(timers_.pop().second);
+    }
+
+    // Called without the lock so that the callback
+    // can schedule more timers.
+    cb();
+    n++;
+  }
+
+  // Did not get to wait in the reactor, wait for a post instead
+  if (!n && !polled && timeout > 0) wait_for_work(timeout);
 
-  // Nothing to do...
-  // std::unique_lock<std::mutex> lk{op_q_lock_};
-  // wait_event_.wait(lk, [this] { return !this->op_q_.is_empty(); });
+  return n;
 }
 
 } // END namespace detail
@@ -8,23 +8,21 @@ extern "C" {
   #include <poll.h>
   #include <unistd.h>
   #include <sys/types.h>
+  #include <sys/uio.h>
   #include <sys/socket.h>
   #include <netinet/in.h>
+  #include <linux/filter.h>
 }
 
 namespace coro_async {
 namespace detail {
 
-void posix_socket_ops::bind(int sockfd, endpoint ep, std::error_code& ec)
+void posix_socket_ops::bind(
+    int sockfd, const sockaddr* addr, socklen_t len, std::error_code& ec)
 {
   ec.clear();
 
-  sockaddr_in address;
-  address.sin_family = AF_INET;
-  address.sin_addr = ep.address().native_addr();
-  address.sin_port = ::htons(ep.port());
-
-  int rc = ::bind(sockfd, (sockaddr*)&address, sizeof(sockaddr_in)); 
+  int rc = ::bind(sockfd, addr, len);
   if (rc != 0)
   {
     ec = std::error_code{errno, std::system_category()};
@@ -44,16 +42,12 @@ void posix_socket_ops::listen(int sockfd, unsigned backlog, std::error_code& ec)
   return;
 }
 
-void posix_socket_ops::connect(int sockfd, endpoint ep, std::error_code& ec)
+void posix_socket_ops::connect(
+    int sockfd, const sockaddr* addr, socklen_t len, std::error_code& ec)
 {
   ec.clear();
 
-  sockaddr_in address;
-  address.sin_family = AF_INET;
-  address.sin_addr = ep.address().native_addr();
-  address.sin_port = ::htons(ep.port());
-
-  int rc = ::connect(sockfd, (sockaddr*)&address, sizeof(sockaddr_in));
+  int rc = ::connect(sockfd, addr, len);
   if (rc != 0)
   {
     switch (errno)
@@ -81,18 +75,84 @@ void posix_socket_ops::connect(int sockfd, endpoint ep, std::error_code& ec)
 std::pair<int, endpoint> posix_socket_ops::accept(int sockfd, std::error_code& ec)
 {
   ec.clear();
-  sockaddr_in client_addr;
+  sockaddr_storage client_addr;
 
-  unsigned int sin_size = sizeof(struct sockaddr_in);
-  int new_fd = ::accept(sockfd, (sockaddr*)&client_addr, &sin_size);
+  socklen_t addr_len = sizeof(client_addr);
+  int new_fd = ::accept(sockfd, (sockaddr*)&client_addr, &addr_len);
   if (new_fd == -1)
+  {
+    ec = std::error_code{errno, std::system_category()};
+    return {new_fd, endpoint{}};
+  }
+
+  return {new_fd, endpoint{(sockaddr*)&client_addr, addr_len}};
+}
+
+void posix_socket_ops::set_option(
+    int sockfd, int level, int optname, int value, std::error_code& ec)
+{
+  ec.clear();
+
+  int rc = ::setsockopt(sockfd, level, optname, &value, sizeof(value));
+  if (rc != 0)
+  {
+    ec = std::error_code{errno, std::system_category()};
+  }
+  return;
+}
+
+int posix_socket_ops::get_option(
+    int sockfd, int level, int optname, std::error_code& ec)
+{
+  ec.clear();
+
+  int value = 0;
+  socklen_t len = sizeof(value);
+  int rc = ::getsockopt(sockfd, level, optname, &value, &len);
+  if (rc != 0)
   {
     ec = std::error_code{errno, std::system_category()};
   }
+  return value;
+}
+
+void posix_socket_ops::set_busy_poll(
+    int sockfd, int usecs, bool prefer, std::error_code& ec)
+{
+  set_option(sockfd, SOL_SOCKET, SO_BUSY_POLL, usecs, ec);
+  if (ec) return;
+#ifdef SO_PREFER_BUSY_POLL
+  set_option(sockfd, SOL_SOCKET, SO_PREFER_BUSY_POLL, prefer ? 1 : 0, ec);
+#else
+  (void)prefer;
+#endif
+}
 
-  v4_address addr{client_addr.sin_addr};
+void posix_socket_ops::attach_cpu_steering(
+    int sockfd, unsigned group_size, std::error_code& ec)
+{
+  ec.clear();
 
-  return {new_fd, endpoint{addr, client_addr.sin_port}};
+  if (group_size == 0)
+  {
+    ec = std::error_code{EINVAL, std::system_category()};
+    return;
+  }
+
+  // A = cpu; A %= group_size; return A
+  sock_filter code[] = {
+    { BPF_LD  | BPF_W   | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU) },
+    { BPF_ALU | BPF_MOD | BPF_K,   0, 0, group_size },
+    { BPF_RET | BPF_A,             0, 0, 0 },
+  };
+  sock_fprog prog = { sizeof(code) / sizeof(code[0]), code };
+
+  int rc = ::setsockopt(sockfd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog));
+  if (rc != 0)
+  {
+    ec = std::error_code{errno, std::system_category()};
+  }
+  return;
 }
 
 bool posix_socket_ops::nb_connect(int sockfd, std::error_code& ec)
@@ -127,6 +187,31 @@ bool posix_socket_ops::nb_connect(int sockfd, std::error_code& ec)
   return true;
 }
 
+bool posix_socket_ops::is_reusable(int sockfd)
+{
+  char c;
+  while (true)
+  {
+    ssize_t rbytes = ::recv(sockfd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+
+    // EOF or unexpected data on an idle connection
+    if (rbytes >= 0) return false;
+
+    switch (errno)
+    {
+      case EINTR:
+        continue;
+      case EAGAIN: // Same as EWOULDBLOCK
+        return true;
+      default:
+        return false;
+    };
+  }
+
+  assert (0 && "Code not reached");
+  return false;
+}
+
 template <typename Buffer>
 bool posix_socket_ops::nb_read(
     int sockfd, Buffer& buf, size_t& bytes_read, std::error_code& ec)
@@ -226,6 +311,205 @@ bool posix_socket_ops::nb_write(
   return false;
 }
 
+std::error_code posix_socket_ops::io_error_code(int err) noexcept
+{
+  switch (err)
+  {
+    case EAGAIN: // Same as EWOULDBLOCK
+      return error::socket_errc::would_block;
+    case EBADF:
+      return error::socket_errc::bad_file_descriptor;
+    case EINVAL:
+      return error::socket_errc::invalid_descriptor;
+    case EFAULT:
+      return error::socket_errc::bad_read_buffer;
+    case EIO:
+      return error::socket_errc::io_error;
+    default:
+      return std::error_code{err, std::system_category()};
+  };
+}
+
+bool posix_socket_ops::nb_recvmmsg(int sockfd, mmsghdr* msgs, unsigned vlen,
+                                   size_t& received, std::error_code& ec)
+{
+  ec.clear();
+  received = 0;
+
+  while (true)
+  {
+    int n = ::recvmmsg(sockfd, msgs, vlen, 0, nullptr);
+
+    if (n >= 0)
+    {
+      received = n;
+      return n > 0;
+    }
+
+    if (errno == EINTR) continue;
+
+    ec = io_error_code(errno);
+    return false;
+  }
+
+  assert (0 && "Code not reached");
+  return false;
+}
+
+bool posix_socket_ops::nb_sendmmsg(int sockfd, mmsghdr* msgs, unsigned vlen,
+                                   size_t& sent, std::error_code& ec)
+{
+  ec.clear();
+  sent = 0;
+
+  while (true)
+  {
+    int n = ::sendmmsg(sockfd, msgs, vlen, 0);
+
+    if (n >= 0)
+    {
+      sent = n;
+      return n > 0;
+    }
+
+    if (errno == EINTR) continue;
+
+    ec = io_error_code(errno);
+    return false;
+  }
+
+  assert (0 && "Code not reached");
+  return false;
+}
+
+template <typename Buffer>
+bool posix_socket_ops::nb_send_fds(int sockfd, const Buffer& buf,
+                                   const int* fds, size_t nfds,
+                                   size_t& bytes_wrote, std::error_code& ec)
+{
+  ec.clear();
+  assert (buf.size() > 0 && "Atleast one byte must carry the descriptors");
+  assert (nfds <= max_passed_fds);
+
+  iovec iov;
+  iov.iov_base = const_cast<char*>(buf.data());
+  iov.iov_len = buf.size();
+
+  union {
+    cmsghdr align_;
+    char buf_[CMSG_SPACE(sizeof(int) * max_passed_fds)];
+  } control;
+  ::memset(&control, 0, sizeof(control));
+
+  msghdr msg;
+  ::memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+
+  if (nfds > 0)
+  {
+    msg.msg_control = control.buf_;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * nfds);
+
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * nfds);
+    ::memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * nfds);
+  }
+
+  while (true)
+  {
+    ssize_t wbytes = ::sendmsg(sockfd, &msg, MSG_NOSIGNAL);
+
+    if (wbytes >= 0)
+    {
+      bytes_wrote = wbytes;
+      return true;
+    }
+
+    if (errno == EINTR) continue;
+
+    ec = io_error_code(errno);
+    return false;
+  }
+
+  assert (0 && "Code not reached");
+  return false;
+}
+
+template <typename Buffer>
+bool posix_socket_ops::nb_recv_fds(int sockfd, Buffer& buf,
+                                   int* fds, size_t max_fds,
+                                   size_t& bytes_read, size_t& nfds, std::error_code& ec)
+{
+  ec.clear();
+  nfds = 0;
+  if (max_fds > max_passed_fds) max_fds = max_passed_fds;
+
+  iovec iov;
+  iov.iov_base = buf.data();
+  iov.iov_len = buf.size();
+
+  union {
+    cmsghdr align_;
+    char buf_[CMSG_SPACE(sizeof(int) * max_passed_fds)];
+  } control;
+
+  msghdr msg;
+  ::memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf_;
+  msg.msg_controllen = CMSG_SPACE(sizeof(int) * max_fds);
+
+  while (true)
+  {
+    ssize_t rbytes = ::recvmsg(sockfd, &msg, MSG_CMSG_CLOEXEC);
+
+    if (rbytes < 0)
+    {
+      if (errno == EINTR) continue;
+      ec = io_error_code(errno);
+      return false;
+    }
+
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+      if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) continue;
+
+      const size_t n = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+      for (size_t i = 0; i < n; i++)
+      {
+        int fd;
+        ::memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+        // Do not leak what does not fit
+        if (nfds < max_fds) fds[nfds++] = fd;
+        else                ::close(fd);
+      }
+    }
+
+    bytes_read = rbytes;
+
+    if (rbytes == 0 && nfds == 0)
+    {
+      ec = error::socket_errc::eof;
+    }
+    else if (msg.msg_flags & MSG_CTRUNC)
+    {
+      // The kernel dropped descriptors which did not fit.
+      // Report it as a whole and do not hand out a partial set.
+      for (size_t i = 0; i < nfds; i++) ::close(fds[i]);
+      nfds = 0;
+      ec = std::error_code{EMSGSIZE, std::system_category()};
+    }
+    return true;
+  }
+
+  assert (0 && "Code not reached");
+  return false;
+}
+
 } // END namspace detail
 } // END namespace coro_async
 
@@ -29,6 +29,22 @@ struct is_coro_task<coro_task_manual<T>> : std::true_type
 {
 };
 
+/**
+ * The promise return_type of a coro_task, else the type itself.
+ * Keeps `T::return_type` from being named for plain types.
+ */
+template <typename T, bool = is_coro_task<T>::value>
+struct unwrap_coro_task
+{
+  using type = T;
+};
+
+template <typename T>
+struct unwrap_coro_task<T, true>
+{
+  using type = typename T::return_type;
+};
+
 /**
  * Deduce handler return type.
  * If coro_task, return the underlying promise return_type.
@@ -38,11 +54,7 @@ struct deduce_return_type
 {
   using handler_return_type = decltype(std::declval<Handler>()());
 
-  using type = typename std::conditional<
-      is_coro_task<handler_return_type>{},
-      typename handler_return_type::return_type,
-      handler_return_type
-    >::type;
+  using type = typename unwrap_coro_task<handler_return_type>::type;
 };
 
 } // END namespace meta
@@ -100,10 +100,11 @@ public: // Queue APIs
     {
       assert (!tail_->next_ && "tail operation cannot point to anything");
       tail_->next_ = op;
+      tail_ = op;
     }
   }
 
-  /// Push an entire queue
+  /// Append an entire queue. `oq` is left empty.
   template <typename OtherOperation>
   void push(operation_queue<OtherOperation>& oq)
   {
@@ -113,11 +114,14 @@ public: // Queue APIs
     {
       head_ = oq.head_;
       tail_ = oq.tail_;
-      return;
+    }
+    else
+    {
+      tail_->next_ = oq.head_;
+      tail_ = oq.tail_;
     }
 
-    oq.tail_->next_ = head_;
-    head_ = oq.head_;
+    oq.head_ = oq.tail_ = nullptr;
   }
 
   /// Checks if the operation is enqueued
@@ -127,6 +131,9 @@ public: // Queue APIs
   }
   
 private:
+  template <typename OtherOperation>
+  friend class operation_queue;
+
   ///
   Operation* head_ = nullptr;
   ///
@@ -34,8 +34,10 @@ namespace detail {
 
 /**
  * Handler for reading data from socket when its ready.
+ * `Stream` is any descriptor backed stream, i.e.
+ * `stream_socket` or `posix_stream_descriptor`.
  */
-template <typename Handler>
+template <typename Handler, typename Stream = stream_socket>
 class read_op: public operation_base
 {
 public:
@@ -46,8 +48,8 @@ public:
    * \param ch - The completion handler.
    */
   template <typename Buffer>
-  read_op(stream_socket& read_sock, const Buffer& buf, Handler&& ch)
-    : operation_base(read_op<Handler>::complete)
+  read_op(Stream& read_sock, const Buffer& buf, Handler&& ch)
+    : operation_base(read_op<Handler, Stream>::complete)
     , read_sock_(read_sock)
     , read_buffer_(buf)
     , ch_(std::forward<Handler>(ch))
@@ -62,7 +64,7 @@ public:
   /// Callback for performing the read when socket is ready for read.
   static void complete(operation_base* op, const std::error_code& ec, size_t bytes_xferred)
   {
-    auto self = static_cast<read_op<Handler>*>(op);
+    auto self = static_cast<read_op<Handler, Stream>*>(op);
 
     if (!ec)
     {
@@ -87,7 +89,7 @@ public:
 
 private:
   /// The read stream socket
-  stream_socket& read_sock_;
+  Stream& read_sock_;
   /// The read buffer
   buffer::buffer_ref read_buffer_;
   /// The user handler to be executed
@@ -99,7 +101,7 @@ private:
  * A composed operation for reading exact number of bytes
  * from socket stream to buffer.
  */
-template <typename Handler>
+template <typename Handler, typename Stream = stream_socket>
           // typename CompletionHandler
 class composed_read_op
 {
@@ -110,7 +112,7 @@ public:
    * \param buf - The buffer view of the read buffer.
    * \param h - The completion handler to be executed on read complete.
    */
-  composed_read_op(stream_socket& sock,
+  composed_read_op(Stream& sock,
                    //TODO: Ouch!!
                    buffer::buffer_ref& buf,
                    Handler&& h)
@@ -190,7 +192,7 @@ public:
 
 private:
   /// The read stream socket
-  stream_socket& read_sock_; 
+  Stream& read_sock_; 
   /// The read buffer
   buffer::buffer_ref& read_buffer_;
   /// Bytes intended to be read
@@ -0,0 +1,60 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_RESUME_OP_HPP
+#define CORO_ASYNC_RESUME_OP_HPP
+
+#include <experimental/coroutine>
+#include "coro-async/detail/operation_base.hpp"
+
+namespace stdex = std::experimental;
+
+namespace coro_async {
+namespace detail {
+
+/**
+ * Resumes a coroutine. Meant to be embedded in an
+ * awaitable, so that resuming needs no allocation.
+ */
+class resume_op: public operation_base
+{
+public:
+  ///
+  resume_op()
+    : operation_base(resume_op::complete)
+  {
+  }
+
+  ///
+  static void complete(operation_base* op, const std::error_code& ec, size_t bytes_xferred)
+  {
+    static_cast<resume_op*>(op)->ch_.resume();
+  }
+
+public:
+  /// The suspended coroutine
+  stdex::coroutine_handle<> ch_ = nullptr;
+};
+
+} // END namespace detail
+} // END namespace coro_async
+
+#endif
@@ -0,0 +1,74 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef CORO_ASYNC_CLOSE_DESCRIPTOR_HPP
+#define CORO_ASYNC_CLOSE_DESCRIPTOR_HPP
+
+#include <cerrno>
+#include <system_error>
+#include "coro-async/detail/descriptor.hpp"
+#include "coro-async/detail/epoll_reactor.hpp"
+#include "coro-async/detail/operation_base.hpp"
+
+namespace coro_async {
+namespace detail {
+
+/**
+ * Take a descriptor registered with the reactor out of service.
+ *
+ * The descriptor is removed from epoll and the operations still
+ * queued on it complete with ECANCELED, posted to `ios`. The state
+ * is freed by a posted handler too, since an event of the epoll
+ * batch being run may still refer to it. Closing the descriptor
+ * itself is left to the caller.
+ *
+ * \param dstate - Set to null. Nothing is done if already null.
+ */
+template <typename IoService>
+void retire_descriptor(IoService& ios,
+                       epoll_reactor& reactor,
+                       descriptor& d,
+                       descriptor_state*& dstate)
+{
+  if (!dstate) return;
+
+  if (d.get() != -1) reactor.deregister_descriptor(d);
+
+  for (auto q : { &dstate->connect_q(), &dstate->wr_q(), &dstate->rd_q() })
+  {
+    while (!dstate->is_op_queue_empty(*q))
+    {
+      auto op = dstate->pop_front_op(*q);
+      ios.post([op] {
+            op->call(op, std::error_code{ECANCELED, std::system_category()}, 0);
+          });
+    }
+  }
+
+  ios.post([state = dstate] { delete state; });
+  dstate = nullptr;
+}
+
+} // END namespace detail
+} // END namespace coro_async
+
+#endif
@@ -24,6 +24,12 @@
 #define CORO_ASYNC_SCHEDULER_HPP
 
 #include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
 #include <system_error>
 #include <condition_variable>
 
@@ -32,22 +38,121 @@
 #include "coro-async/detail/scheduler_op.hpp"
 #include "coro-async/detail/epoll_reactor.hpp"
 #include "coro-async/detail/operation_queue.hpp"
+#include "coro-async/detail/chase_lev_deque.hpp"
+#include "coro-async/detail/threading_policy.hpp"
+#include "coro-async/detail/unique_function.hpp"
 
 namespace coro_async {
+
+/**
+ * How the posted operations are distributed among the
+ * threads running the scheduler.
+ */
+enum class scheduling_policy
+{
+  /// A single shared FIFO queue.
+  fifo,
+  /**
+   * Every running thread gets its own deque. Operations posted
+   * from a running thread go to its deque and are run by it in
+   * LIFO order; idle threads steal the oldest ones. Operations
+   * posted from outside go to the shared FIFO queue.
+   * Meant for CPU heavy handlers. There is no ordering
+   * guarantee between posted operations.
+   */
+  work_stealing,
+};
+
+/**
+ * The priority class of a posted operation or of the
+ * completions of a socket.
+ */
+enum class priority
+{
+  /// Bulk and regular work
+  normal,
+  /**
+   * Latency sensitive work, eg. health checks and control
+   * messages. Run before the normal work queued up, but a
+   * long run of it still lets normal work through.
+   */
+  high,
+};
+
+/**
+ * Counters of an event loop since it was created.
+ * Diff two samples with `since` to get them for a window.
+ */
+struct loop_stats
+{
+  /// Wall clock time covered
+  std::chrono::nanoseconds uptime{0};
+  /// Time blocked waiting for work or spinning for it
+  std::chrono::nanoseconds idle_time{0};
+  /// The part of `idle_time` spent spinning
+  std::chrono::nanoseconds spin_time{0};
+  /// Spins which found work before the budget ran out
+  uint64_t spin_hits = 0;
+  /// Times the loop blocked in the reactor
+  uint64_t sleeps = 0;
+
+  /// Fraction (0..1) of the time spent running handlers
+  double utilization() const noexcept
+  {
+    if (uptime.count() <= 0) return 0.0;
+    const double u = 1.0 - static_cast<double>(idle_time.count()) / uptime.count();
+    return u < 0.0 ? 0.0 : u;
+  }
+
+  /// The counters for the window since `earlier`
+  loop_stats since(const loop_stats& earlier) const noexcept
+  {
+    return { uptime - earlier.uptime,
+             idle_time - earlier.idle_time,
+             spin_time - earlier.spin_time,
+             spin_hits - earlier.spin_hits,
+             sleeps - earlier.sleeps };
+  }
+};
+
 namespace detail     {
 
+/**
+ * Work which the scheduler polls once per loop iteration,
+ * eg. the cross shard mailboxes.
+ */
+struct loop_hook
+{
+  /// Run the ready work. Returns the number of handlers run.
+  size_t (*poll_)(void* ctx) = nullptr;
+  /// Is there work which must not wait on the reactor.
+  bool (*pending_)(void* ctx) = nullptr;
+  /// Passed to the callbacks
+  void* ctx_ = nullptr;
+};
+
 /**
  * Schedules an operation.
+ * `Threading` is `multi_threaded` or `single_threaded`, it
+ * provides the locks and the atomics.
  */
-class scheduler
+template <typename Threading>
+class basic_scheduler
 {
 public:
   /// Default cons.
-  scheduler();
+  basic_scheduler();
+
+  /**
+   * \param policy - How posted operations are distributed.
+   * \param concurrency - Max threads that get a work stealing
+   *                      deque. The rest only use the shared queue.
+   */
+  basic_scheduler(scheduling_policy policy, size_t concurrency);
 
   /// Non copyable and non assignable
-  scheduler(const scheduler&) = delete;
-  scheduler& operator=(const scheduler&) = delete;
+  basic_scheduler(const basic_scheduler&) = delete;
+  basic_scheduler& operator=(const basic_scheduler&) = delete;
 
 public: // Scheduler APIs
   /// Get the underlying reactor.
@@ -61,7 +166,25 @@ public: // Scheduler APIs
    * execution.
    */
   template <typename Handler>
-  void post(scheduler_op<Handler>* op);
+  void post(scheduler_op<Handler>* op, priority prio = priority::normal);
+
+  /**
+   * Adds an operation owned by the caller to the queue.
+   * It is called with an empty error code.
+   */
+  void post_op(operation_base* op, priority prio = priority::normal);
+
+  /**
+   * Adds an operation owned by the caller to be run in the
+   * next loop iteration, after the reactor has been polled.
+   */
+  void defer_op(operation_base* op);
+
+  /// Max posted operations run per loop iteration. 0 for no bound.
+  void set_handler_budget(size_t budget) noexcept
+  {
+    handler_budget_ = budget ? budget : unbounded;
+  }
 
   /**
    * Schedules an operation after `secs` seconds.
@@ -73,12 +196,186 @@ public: // Scheduler APIs
   template <typename T>
   void schedule_after(std::chrono::milliseconds msecs, T&& cb);
 
-  /// Run the scheduler.
-  void run(std::error_code& ec);
+  /**
+   * Run the scheduler till `stop` is called.
+   * Returns the number of handlers executed.
+   */
+  size_t run(std::error_code& ec);
+
+  /**
+   * Wait till atleast one handler is executed or the
+   * scheduler is stopped.
+   * A descriptor reporting more than one ready operation
+   * (eg. read and write) runs all of them.
+   */
+  size_t run_one(std::error_code& ec);
+
+  /// Run the handlers which are ready, without waiting.
+  size_t poll(std::error_code& ec);
+
+  /// Run atmost one ready handler, without waiting.
+  size_t poll_one(std::error_code& ec);
+
+  /// Run the scheduler for `dur` or till it is stopped.
+  template <typename Rep, typename Period>
+  size_t run_for(const std::chrono::duration<Rep, Period>& dur, std::error_code& ec);
+
+  /**
+   * Make the running `run` / `run_one` / `run_for` return.
+   * Can be called from any thread.
+   */
+  void stop() noexcept
+  {
+    stopped_.store(true, std::memory_order_release);
+  }
+
+  /// Is the scheduler stopped.
+  bool stopped() const noexcept
+  {
+    return stopped_.load(std::memory_order_acquire);
+  }
+
+  /// Reset the stopped state to allow running again.
+  void restart() noexcept
+  {
+    stopped_.store(false, std::memory_order_release);
+  }
+
+  /**
+   * Interrupt the thread blocked in the reactor, if any.
+   * The caller must have made its work visible before,
+   * eg. pushed it on a queue checked by a `loop_hook`.
+   * Thread safe.
+   */
+  void wake() noexcept;
+
+  /**
+   * Add a hook run by every loop iteration.
+   * Not thread safe: to be called before running the scheduler.
+   */
+  void add_loop_hook(const loop_hook* hook);
+
+  /// Remove a hook added by `add_loop_hook`. Not thread safe.
+  void remove_loop_hook(const loop_hook* hook);
+
+  /**
+   * Total time the running threads spent blocked waiting (or
+   * spinning) for work. Sampled against the wall clock it gives
+   * the utilization of the loop. Thread safe.
+   */
+  std::chrono::nanoseconds idle_time() const noexcept
+  {
+    return std::chrono::nanoseconds{idle_ns_.load(std::memory_order_relaxed)};
+  }
+
+  /**
+   * Before blocking in the reactor, poll it without a timeout
+   * for upto `budget`. Trades a busy core for the wake up
+   * latency of a blocked thread. 0 (the default) turns it off.
+   * To be set before running the scheduler.
+   */
+  void set_spin_budget(std::chrono::nanoseconds budget) noexcept
+  {
+    spin_budget_ = budget;
+  }
+
+  /// The loop counters. Thread safe.
+  loop_stats stats() const noexcept;
 
 private:
   ///
-  void do_run_locked(const std::error_code& ec);
+  using mutex_type = typename Threading::mutex_type;
+
+  ///
+  template <typename T>
+  using atomic_type = typename Threading::template atomic_type<T>;
+
+  /// The per thread state for work stealing
+  struct alignas(64) worker
+  {
+    /// Operations posted by the thread owning the slot
+    chase_lev_deque<operation_base*> queue_;
+    /// Whether a running thread owns the slot
+    atomic_type<bool> claimed_{false};
+  };
+
+  /// The worker slot of the calling thread
+  struct current_worker
+  {
+    basic_scheduler* owner_;
+    worker* worker_;
+  };
+
+  /// Claims a worker slot for the calling thread while it runs.
+  class worker_scope
+  {
+  public:
+    worker_scope(basic_scheduler& sched);
+    ~worker_scope();
+
+    worker_scope(const worker_scope&) = delete;
+    worker_scope& operator=(const worker_scope&) = delete;
+
+  private:
+    current_worker prev_;
+    worker* claimed_ = nullptr;
+  };
+
+  /// The worker slot of the calling thread, if any
+  worker* this_worker() const noexcept
+  {
+    return current_.owner_ == this ? current_.worker_ : nullptr;
+  }
+
+  /// High priority, own deque, the shared queue, then steal.
+  operation_base* next_op();
+
+  /// Steal from the other workers.
+  operation_base* steal(worker* self);
+
+  /// Is there any operation waiting to be run.
+  bool has_queued_work();
+
+  /// Is there any operation in the worker deques.
+  bool has_deque_work();
+
+  /// Do the loop hooks have work. Reactor lock holder only.
+  bool hooks_pending();
+
+  /// Block for upto `timeout` ms waiting for a post.
+  void wait_for_work(int timeout);
+
+  /// Account the time since `start` as idle.
+  void add_idle_time(std::chrono::steady_clock::time_point start) noexcept;
+
+  /**
+   * Poll the reactor for upto the spin budget, till something
+   * is ready. Reactor lock holder only.
+   * \returns Whether the spin found work.
+   */
+  bool spin(size_t max_events, size_t& n);
+
+  /**
+   * Run the reactor, the posted operations and the expired
+   * timers once.
+   * \param timeout - epoll wait time in milliseconds. Not waited
+   *                  upon if there are posted operations.
+   * \param max_handlers - Upper bound on the handlers executed.
+   */
+  size_t do_run_once(int timeout, size_t max_handlers, const std::error_code& ec);
+
+private:
+  /// Max time a running scheduler blocks in the reactor
+  static constexpr int reactor_tick_ms = 2;
+
+  /// No bound on the handlers run
+  static constexpr size_t unbounded = static_cast<size_t>(-1);
+
+  /// High priority operations run in a row before a normal one
+  static constexpr size_t max_high_streak = 16;
+
+  /// Posted operations run per loop iteration by default
+  static constexpr size_t default_handler_budget = 256;
 
 private:
   /// The reactor
@@ -88,17 +385,82 @@ private:
   /// for execution.
   operation_queue<operation_base> op_q_;
 
+  /// High priority operations. Shared by all the threads,
+  /// under `op_q_lock_`.
+  operation_queue<operation_base> hi_q_;
+
+  /// Number of operations in `hi_q_`, checked without the lock
+  atomic_type<size_t> hi_count_{0};
+
+  /// High priority operations run in a row (under `op_q_lock_`)
+  size_t hi_streak_ = 0;
+
+  /// Operations for the next loop iteration (under `op_q_lock_`)
+  operation_queue<operation_base> deferred_q_;
+
+  /// Number of operations in `deferred_q_`, checked without the lock
+  atomic_type<size_t> deferred_count_{0};
+
+  /// Max posted operations run per loop iteration
+  size_t handler_budget_ = default_handler_budget;
+
   /// Timer queue
-  timer_queue<std::function<void()>> timers_;
+  timer_queue<unique_function<void()>> timers_;
 
   /// Lock to protect access to operation_queue
-  std::mutex op_q_lock_;
+  mutex_type op_q_lock_;
 
   /// Lock to protect timer queue access
-  std::mutex timer_q_lock_;
+  mutex_type timer_q_lock_;
 
   /// Wait event
-  std::condition_variable wait_event_;
+  typename Threading::condition_variable_type wait_event_;
+
+  /// Set by `stop`
+  atomic_type<bool> stopped_{false};
+
+  /// Only one thread at a time waits in the reactor
+  mutex_type reactor_lock_;
+
+  /// Set while a thread may be blocked in the reactor
+  atomic_type<bool> reactor_sleeping_{false};
+
+  /// Polled once per loop iteration
+  std::vector<const loop_hook*> hooks_;
+
+  /// Threads blocked in `wait_for_work`
+  atomic_type<int> idle_waiters_{0};
+
+  /// Nanoseconds spent blocked in the reactor or `wait_for_work`,
+  /// or spinning
+  atomic_type<uint64_t> idle_ns_{0};
+
+  /// Nanoseconds spent spinning
+  atomic_type<uint64_t> spin_ns_{0};
+
+  /// Spins which found work
+  atomic_type<uint64_t> spin_hits_{0};
+
+  /// Blocking reactor waits
+  atomic_type<uint64_t> sleeps_{0};
+
+  /// Spin before blocking in the reactor
+  std::chrono::nanoseconds spin_budget_{0};
+
+  /// When the scheduler was created
+  const std::chrono::steady_clock::time_point created_ = std::chrono::steady_clock::now();
+
+  /// How posted operations are distributed
+  scheduling_policy policy_ = scheduling_policy::fifo;
+
+  /// Worker slots (work stealing only)
+  std::unique_ptr<worker[]> workers_;
+
+  /// Number of worker slots
+  size_t num_workers_ = 0;
+
+  /// The calling thread's worker slot (zero initialized)
+  static inline thread_local current_worker current_;
 };
 
 } // END namespace detsil
@@ -30,6 +30,7 @@ namespace detail {
 
 /**
  * Handler for operations posted on the scheduler.
+ * Always heap allocated: it deletes itself when completed.
  */
 template <typename Handler>
 class scheduler_op: public operation_base
@@ -49,11 +50,15 @@ public:
   scheduler_op& operator=(const scheduler_op&) = default;
 
 public:
-  /// Invokes the completion handler.
+  /// Frees the operation and invokes the completion handler.
   static void complete(operation_base* op, const std::error_code& ec, size_t bytes_xferred)
   {
     auto self = static_cast<scheduler_op<Handler>*>(op);
-    self->ch_();
+    // Freed before the call, so that a handler posting
+    // more work does not pile up the operations.
+    Handler ch{std::move(self->ch_)};
+    delete self;
+    ch();
 
     return;
   }
@@ -0,0 +1,85 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_SIGNAL_OP_HPP
+#define CORO_ASYNC_SIGNAL_OP_HPP
+
+#include "coro-async/signal_set.hpp"
+#include "coro-async/detail/reactor_ops.hpp"
+#include "coro-async/detail/operation_base.hpp"
+
+namespace coro_async {
+namespace detail {
+
+/**
+ * Handler for reading a signal off the signalfd
+ * of a `signal_set`.
+ * The handler signature is:
+ *   void(const std::error_code&, int signo)
+ */
+template <typename Handler>
+class signal_op: public operation_base
+{
+public:
+  ///
+  signal_op(signal_set& sigs, Handler&& ch)
+    : operation_base(signal_op<Handler>::complete)
+    , sigs_(sigs)
+    , ch_(std::forward<Handler>(ch))
+  {
+  }
+
+  /// Non copyable, non assignable.
+  signal_op(const signal_op&) = delete;
+  signal_op& operator=(const signal_op&) = delete;
+
+public:
+  /// Callback when the signalfd is readable.
+  static void complete(operation_base* op, const std::error_code& ec, size_t bytes_xferred)
+  {
+    auto self = static_cast<signal_op<Handler>*>(op);
+
+    int signo = 0;
+    std::error_code read_err = ec;
+    if (!ec && !self->sigs_.read_pending(signo, read_err) && !read_err)
+    {
+      // Another waiter took the signal
+      self->sigs_.start_reactor_op(reactor_ops::read_op, self);
+      return;
+    }
+
+    // Freed before the call, the handler may wait again
+    Handler ch{std::move(self->ch_)};
+    delete self;
+    ch(read_err, signo);
+  }
+
+private:
+  /// The signal set
+  signal_set& sigs_;
+  /// The user handler to be executed
+  Handler ch_;
+};
+
+} // END namespace detail
+} // END namespace coro_async
+
+#endif
@@ -36,14 +36,37 @@ namespace detail {
 class posix_socket_ops
 {
 public:
+  /// Max descriptors passed in a single `nb_send_fds` / `nb_recv_fds`
+  static constexpr size_t max_passed_fds = 16;
+
+  /**
+   * `bind` system call.
+   * `Endpoint` is either `endpoint` or `local_endpoint`.
+   */
+  template <typename Endpoint>
+  static void bind(int sockfd, const Endpoint& ep, std::error_code& ec)
+  {
+    bind(sockfd, ep.data(), ep.size(), ec);
+  }
+
   /// `bind` system call
-  static void bind(int sockfd, endpoint ep, std::error_code& ec);
+  static void bind(int sockfd, const sockaddr* addr, socklen_t len, std::error_code& ec);
 
   /// `listen` system call
   static void listen(int sockfd, unsigned backlog, std::error_code& ec);
 
+  /**
+   * `connect` system call.
+   * `Endpoint` is either `endpoint` or `local_endpoint`.
+   */
+  template <typename Endpoint>
+  static void connect(int sockfd, const Endpoint& ep, std::error_code& ec)
+  {
+    connect(sockfd, ep.data(), ep.size(), ec);
+  }
+
   /// `connect` system call
-  static void connect(int sockfd, endpoint ep, std::error_code& ec);
+  static void connect(int sockfd, const sockaddr* addr, socklen_t len, std::error_code& ec);
 
   /**
    * `accept` system call
@@ -51,9 +74,40 @@ public:
    */
   static std::pair<int, endpoint> accept(int sockfd, std::error_code& ec);
 
+  /// `setsockopt` system call for integer valued options
+  static void set_option(int sockfd, int level, int optname, int value, std::error_code& ec);
+
+  /// `getsockopt` system call for integer valued options
+  static int get_option(int sockfd, int level, int optname, std::error_code& ec);
+
+  /**
+   * Busy poll the device queue of the socket for upto `usecs`
+   * on blocking reads and `epoll_wait` (SO_BUSY_POLL), and
+   * prefer that over interrupts (SO_PREFER_BUSY_POLL).
+   * Raising `usecs` above net.core.busy_read needs CAP_NET_ADMIN.
+   */
+  static void set_busy_poll(int sockfd, int usecs, bool prefer, std::error_code& ec);
+
+  /**
+   * Attach a classic BPF program to the SO_REUSEPORT group of
+   * `sockfd` which picks the listener `cpu % group_size`, where
+   * `cpu` is the one which received the packet.
+   */
+  static void attach_cpu_steering(int sockfd, unsigned group_size, std::error_code& ec);
+
   /// `connect` system call (always on non-blocking socket)
   static bool nb_connect(int sockfd, std::error_code& ec);
 
+  /**
+   * Checks if an idle connected socket can be reused.
+   *
+   * Returns-
+   * true : Connection is alive and has no unread data.
+   * false : Peer closed the connection, socket is in error
+   *         or there is stray data pending on it.
+   */
+  static bool is_reusable(int sockfd);
+
   /**
    * Non blocking socket read.
    *
@@ -74,6 +128,67 @@ public:
   template <typename Buffer>
   static bool nb_write(
       int sockfd, const Buffer& buf, size_t& bytes_wrote, std::error_code& ec);
+
+  /**
+   * Non blocking `sendmsg` of the data in `buf` along with
+   * `nfds` descriptors as SCM_RIGHTS ancillary data.
+   * Only for unix domain sockets. `buf` must not be empty.
+   *
+   * Returns-
+   * true: The message was sent (the descriptors go out
+   *       with the first byte).
+   * false: Nothing was sent.
+   */
+  template <typename Buffer>
+  static bool nb_send_fds(int sockfd, const Buffer& buf,
+                          const int* fds, size_t nfds,
+                          size_t& bytes_wrote, std::error_code& ec);
+
+  /**
+   * Non blocking `recvmsg` into `buf` collecting upto `max_fds`
+   * descriptors passed as SCM_RIGHTS ancillary data into `fds`.
+   * The received descriptors are close-on-exec and owned by
+   * the caller.
+   *
+   * If more descriptors were passed than fit, they are all
+   * closed and `ec` is set to EMSGSIZE.
+   *
+   * Returns-
+   * true: Data was read, `nfds` descriptors were received.
+   * false: Nothing to read.
+   */
+  template <typename Buffer>
+  static bool nb_recv_fds(int sockfd, Buffer& buf,
+                          int* fds, size_t max_fds,
+                          size_t& bytes_read, size_t& nfds, std::error_code& ec);
+
+  /**
+   * Non blocking `recvmmsg`.
+   * Receives upto `vlen` datagrams, `received` is set to
+   * the number of messages filled in.
+   *
+   * Returns-
+   * true: Atleast one datagram was received.
+   * false: Nothing to read (`would_block`) or error.
+   */
+  static bool nb_recvmmsg(int sockfd, mmsghdr* msgs, unsigned vlen,
+                          size_t& received, std::error_code& ec);
+
+  /**
+   * Non blocking `sendmmsg`.
+   * Sends upto `vlen` datagrams, `sent` is set to the number
+   * of messages handed over to the kernel.
+   *
+   * Returns-
+   * true: Atleast one datagram was sent.
+   * false: Socket buffer full (`would_block`) or error.
+   */
+  static bool nb_sendmmsg(int sockfd, mmsghdr* msgs, unsigned vlen,
+                          size_t& sent, std::error_code& ec);
+
+private:
+  /// Maps the `errno` of a failed read / write call
+  static std::error_code io_error_code(int err) noexcept;
 };
 
 } // END namespace detail
@@ -0,0 +1,134 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef CORO_ASYNC_SPSC_RING_HPP
+#define CORO_ASYNC_SPSC_RING_HPP
+
+#include <atomic>
+#include <memory>
+#include <cassert>
+
+namespace coro_async {
+namespace detail {
+
+/**
+ * A bounded single producer single consumer ring.
+ *
+ * The only synchronization is an acquire / release pair on
+ * each index. Each side keeps a cached copy of the other side's
+ * index and only reloads it when the ring looks full (producer)
+ * or empty (consumer), so the shared cache lines are touched
+ * once per batch rather than once per element.
+ */
+template <typename T>
+class spsc_ring
+{
+public:
+  ///
+  explicit spsc_ring(size_t capacity)
+  {
+    size_t cap = 2;
+    while (cap < capacity) cap <<= 1;
+    mask_ = cap - 1;
+    slots_.reset(new T[cap]);
+  }
+
+  /// Non copyable and non assignable
+  spsc_ring(const spsc_ring&) = delete;
+  spsc_ring& operator=(const spsc_ring&) = delete;
+
+public:
+  /// Producer only. Returns false if the ring is full.
+  bool push(T item)
+  {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ > mask_)
+    {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ > mask_) return false;
+    }
+
+    slots_[tail & mask_] = std::move(item);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Producer only. A `push` right after a false return succeeds.
+  bool full() noexcept
+  {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ > mask_)
+    {
+      cached_head_ = head_.load(std::memory_order_acquire);
+    }
+    return tail - cached_head_ > mask_;
+  }
+
+  /// Consumer only. Returns false if the ring is empty.
+  bool pop(T& item)
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_)
+    {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_) return false;
+    }
+
+    item = std::move(slots_[head & mask_]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Consumer only.
+  bool empty() const noexcept
+  {
+    return head_.load(std::memory_order_relaxed) ==
+           tail_.load(std::memory_order_acquire);
+  }
+
+  ///
+  size_t capacity() const noexcept
+  {
+    return mask_ + 1;
+  }
+
+private:
+  /// Consumer index
+  alignas(64) std::atomic<size_t> head_{0};
+  /// Consumer's copy of `tail_`
+  size_t cached_tail_ = 0;
+
+  /// Producer index
+  alignas(64) std::atomic<size_t> tail_{0};
+  /// Producer's copy of `head_`
+  size_t cached_head_ = 0;
+
+  /// Capacity - 1
+  alignas(64) size_t mask_ = 0;
+  ///
+  std::unique_ptr<T[]> slots_;
+};
+
+} // END namespace detail
+} // END namespace coro_async
+
+#endif
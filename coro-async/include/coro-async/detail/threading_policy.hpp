@@ -0,0 +1,167 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef CORO_ASYNC_THREADING_POLICY_HPP
+#define CORO_ASYNC_THREADING_POLICY_HPP
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
+namespace coro_async {
+namespace detail     {
+
+/// A mutex which does nothing.
+struct null_mutex
+{
+  void lock() noexcept {}
+  bool try_lock() noexcept { return true; }
+  void unlock() noexcept {}
+};
+
+/**
+ * A condition variable which never blocks.
+ * A single threaded scheduler never waits on it.
+ */
+struct null_condition_variable
+{
+  void notify_one() noexcept {}
+  void notify_all() noexcept {}
+
+  template <typename Lock, typename Rep, typename Period>
+  std::cv_status wait_for(Lock&, const std::chrono::duration<Rep, Period>&) noexcept
+  {
+    return std::cv_status::timeout;
+  }
+};
+
+/**
+ * A plain value with the interface of `std::atomic`.
+ * The memory orders are accepted and ignored.
+ */
+template <typename T>
+class null_atomic
+{
+public:
+  ///
+  constexpr null_atomic(T v = T{}) noexcept
+    : v_(v)
+  {
+  }
+
+  null_atomic(const null_atomic&) = delete;
+  null_atomic& operator=(const null_atomic&) = delete;
+
+public:
+  T load(std::memory_order = std::memory_order_seq_cst) const noexcept
+  {
+    return v_;
+  }
+
+  void store(T v, std::memory_order = std::memory_order_seq_cst) noexcept
+  {
+    v_ = v;
+  }
+
+  T exchange(T v, std::memory_order = std::memory_order_seq_cst) noexcept
+  {
+    T old = v_;
+    v_ = v;
+    return old;
+  }
+
+  T fetch_add(T d, std::memory_order = std::memory_order_seq_cst) noexcept
+  {
+    T old = v_;
+    v_ += d;
+    return old;
+  }
+
+  T fetch_sub(T d, std::memory_order = std::memory_order_seq_cst) noexcept
+  {
+    T old = v_;
+    v_ -= d;
+    return old;
+  }
+
+private:
+  T v_;
+};
+
+} // END namespace detail
+
+/**
+ * The threading policy of a scheduler whose io_service is
+ * run and posted to from any number of threads.
+ */
+struct multi_threaded
+{
+  ///
+  static constexpr bool concurrent = true;
+
+  using mutex_type = std::mutex;
+
+  using condition_variable_type = std::condition_variable;
+
+  template <typename T>
+  using atomic_type = std::atomic<T>;
+
+  ///
+  static void fence() noexcept
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+};
+
+/**
+ * The threading policy of a scheduler whose io_service is
+ * only ever touched by the one thread running it: the locks,
+ * the atomics and the wake ups are compiled out.
+ *
+ * NOTE: Posting from another thread is then a data race.
+ * The components completing work from other threads (the
+ * thread_pool backed async_file, coro_file and write_ahead_log,
+ * the resolver, offload, schedule_on, handoff, shard_mesh and
+ * accept_distributor) reject such an io_service at compile time.
+ */
+struct single_threaded
+{
+  ///
+  static constexpr bool concurrent = false;
+
+  using mutex_type = detail::null_mutex;
+
+  using condition_variable_type = detail::null_condition_variable;
+
+  template <typename T>
+  using atomic_type = detail::null_atomic<T>;
+
+  ///
+  static void fence() noexcept
+  {
+  }
+};
+
+} // END namespace coro_async
+
+#endif
@@ -23,7 +23,7 @@
 #ifndef CORO_ASYNC_DETAIL_TIMER_QUEUE_HPP
 #define CORO_ASYNC_DETAIL_TIMER_QUEUE_HPP
 
-#include <queue>
+#include <algorithm>
 #include <chrono>
 #include <vector>
 
@@ -46,34 +46,46 @@ public:
   ///
   timer_queue() = default;
 
-  timer_queue(const timer_queue&) = default;
-  timer_queue& operator=(const timer_queue&) = default;
+  timer_queue(const timer_queue&) = delete;
+  timer_queue& operator=(const timer_queue&) = delete;
 
 public:
   ///
   void add(const std::chrono::seconds sec, T&& ctx)
   {
     const auto val = current_time() + time_type(sec);
-    q_.push( {val, std::forward<T>(ctx)} );
+    q_.emplace_back(val, std::forward<T>(ctx));
+    std::push_heap(q_.begin(), q_.end(), element_type_cmp{});
   }
 
   ///
   void add(const std::chrono::milliseconds msec, T&& ctx)
   {
     const auto val = current_time() + msec;
-    q_.push( {val, std::forward<T>(ctx)} );
+    q_.emplace_back(val, std::forward<T>(ctx));
+    std::push_heap(q_.begin(), q_.end(), element_type_cmp{});
   }
 
   ///
   const element_type& peek() const noexcept
   {
-    return q_.top();
+    return q_.front();
   }
 
   /// Removes the top element from the queue
   void remove()
   {
-    q_.pop();
+    std::pop_heap(q_.begin(), q_.end(), element_type_cmp{});
+    q_.pop_back();
+  }
+
+  /// Removes the top element from the queue and returns it
+  element_type pop()
+  {
+    std::pop_heap(q_.begin(), q_.end(), element_type_cmp{});
+    element_type top = std::move(q_.back());
+    q_.pop_back();
+    return top;
   }
 
   ///
@@ -98,8 +110,9 @@ private:
     }
   };
 
-  /// The timer queue
-  std::priority_queue<element_type, container_type, element_type_cmp> q_;
+  /// The timer queue, a min heap on the expiry time.
+  /// A plain heap so that the callbacks can be moved out.
+  container_type q_;
 };
 
 } // END namespace detail
@@ -0,0 +1,243 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef CORO_ASYNC_UNIQUE_FUNCTION_HPP
+#define CORO_ASYNC_UNIQUE_FUNCTION_HPP
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+namespace coro_async {
+namespace detail     {
+
+template <typename Signature, size_t InlineSize = 48>
+class unique_function;
+
+/**
+ * A move only `std::function`.
+ * Callables of upto `InlineSize` bytes, which are nothrow
+ * move constructible, are stored inline and never allocate.
+ * Bigger ones go to the heap. Being move only, it can hold
+ * lambdas capturing move only types (eg. unique_ptr).
+ */
+template <typename R, typename... Args, size_t InlineSize>
+class unique_function<R(Args...), InlineSize>
+{
+public:
+  ///
+  unique_function() noexcept = default;
+
+  ///
+  unique_function(std::nullptr_t) noexcept
+  {
+  }
+
+  ///
+  template <typename F,
+            typename = std::enable_if_t<
+              !std::is_same<std::decay_t<F>, unique_function>{} &&
+              std::is_invocable_r<R, std::decay_t<F>&, Args...>{}>>
+  unique_function(F&& f)
+  {
+    construct(std::forward<F>(f));
+  }
+
+  ///
+  unique_function(unique_function&& other) noexcept
+  {
+    move_from(other);
+  }
+
+  ///
+  unique_function& operator=(unique_function&& other) noexcept
+  {
+    if (this != &other)
+    {
+      reset();
+      move_from(other);
+    }
+    return *this;
+  }
+
+  ///
+  unique_function& operator=(std::nullptr_t) noexcept
+  {
+    reset();
+    return *this;
+  }
+
+  ///
+  template <typename F,
+            typename = std::enable_if_t<
+              !std::is_same<std::decay_t<F>, unique_function>{} &&
+              std::is_invocable_r<R, std::decay_t<F>&, Args...>{}>>
+  unique_function& operator=(F&& f)
+  {
+    reset();
+    construct(std::forward<F>(f));
+    return *this;
+  }
+
+  /// Non copyable
+  unique_function(const unique_function&) = delete;
+  unique_function& operator=(const unique_function&) = delete;
+
+  ~unique_function()
+  {
+    reset();
+  }
+
+public:
+  ///
+  R operator()(Args... args)
+  {
+    return vtbl_->invoke_(&storage_, std::forward<Args>(args)...);
+  }
+
+  ///
+  explicit operator bool() const noexcept
+  {
+    return vtbl_ != nullptr;
+  }
+
+  /// Can a callable of type `F` be held without allocating.
+  template <typename F>
+  static constexpr bool is_inline() noexcept
+  {
+    return sizeof(F) <= InlineSize &&
+           alignof(F) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible<F>::value;
+  }
+
+private:
+  /// Operations on the held callable
+  struct vtable
+  {
+    R (*invoke_)(void* s, Args&&... args);
+    /// Move constructs into `dst` and destroys the source
+    void (*relocate_)(void* dst, void* src) noexcept;
+    void (*destroy_)(void* s) noexcept;
+  };
+
+  /// For callables stored inline
+  template <typename F>
+  struct inline_ops
+  {
+    static R invoke(void* s, Args&&... args)
+    {
+      return (*static_cast<F*>(s))(std::forward<Args>(args)...);
+    }
+
+    static void relocate(void* dst, void* src) noexcept
+    {
+      ::new (dst) F(std::move(*static_cast<F*>(src)));
+      static_cast<F*>(src)->~F();
+    }
+
+    static void destroy(void* s) noexcept
+    {
+      static_cast<F*>(s)->~F();
+    }
+
+    static constexpr vtable table{ &invoke, &relocate, &destroy };
+  };
+
+  /// For callables stored on the heap
+  template <typename F>
+  struct heap_ops
+  {
+    static F*& ptr(void* s) noexcept
+    {
+      return *static_cast<F**>(s);
+    }
+
+    static R invoke(void* s, Args&&... args)
+    {
+      return (*ptr(s))(std::forward<Args>(args)...);
+    }
+
+    static void relocate(void* dst, void* src) noexcept
+    {
+      ::new (dst) F*(ptr(src));
+    }
+
+    static void destroy(void* s) noexcept
+    {
+      delete ptr(s);
+    }
+
+    static constexpr vtable table{ &invoke, &relocate, &destroy };
+  };
+
+  template <typename F>
+  void construct(F&& f)
+  {
+    using fn_type = std::decay_t<F>;
+
+    if constexpr (std::is_pointer<fn_type>{} || std::is_member_pointer<fn_type>{})
+    {
+      if (f == nullptr) return;
+    }
+
+    if constexpr (is_inline<fn_type>())
+    {
+      ::new (static_cast<void*>(&storage_)) fn_type(std::forward<F>(f));
+      vtbl_ = &inline_ops<fn_type>::table;
+    }
+    else
+    {
+      ::new (static_cast<void*>(&storage_)) fn_type*(new fn_type(std::forward<F>(f)));
+      vtbl_ = &heap_ops<fn_type>::table;
+    }
+  }
+
+  void move_from(unique_function& other) noexcept
+  {
+    if (!other.vtbl_) return;
+    other.vtbl_->relocate_(&storage_, &other.storage_);
+    vtbl_ = other.vtbl_;
+    other.vtbl_ = nullptr;
+  }
+
+  void reset() noexcept
+  {
+    if (!vtbl_) return;
+    vtbl_->destroy_(&storage_);
+    vtbl_ = nullptr;
+  }
+
+private:
+  /// The callable, or a pointer to it
+  std::aligned_storage_t<
+    (InlineSize < sizeof(void*) ? sizeof(void*) : InlineSize),
+    alignof(std::max_align_t)> storage_;
+
+  /// Null when empty
+  const vtable* vtbl_ = nullptr;
+};
+
+} // END namespace detail
+} // END namespace coro_async
+
+#endif
@@ -34,8 +34,10 @@ namespace detail {
 
 /**
  * Handler for socket write operation.
+ * `Stream` is any descriptor backed stream, i.e.
+ * `stream_socket` or `posix_stream_descriptor`.
  */
-template <typename Handler>
+template <typename Handler, typename Stream = stream_socket>
 class write_op: public operation_base
 {
 public:
@@ -46,8 +48,8 @@ public:
    * \param ch - The completion handler to be called on write completion.
    */
   template <typename Buffer>
-  write_op(stream_socket& write_sock, const Buffer& buf, Handler&& ch)
-    : operation_base(write_op<Handler>::complete)
+  write_op(Stream& write_sock, const Buffer& buf, Handler&& ch)
+    : operation_base(write_op<Handler, Stream>::complete)
     , write_sock_(write_sock)
     , write_buffer_(buf)
     , ch_(std::forward<Handler>(ch))
@@ -62,7 +64,7 @@ public:
   /// Callback when the socket is ready to be written to.
   static void complete(operation_base* op, const std::error_code& ec, size_t bytes_xferred)
   {
-    auto self = static_cast<write_op<Handler>*>(op);
+    auto self = static_cast<write_op<Handler, Stream>*>(op);
 
     if (!ec)
     {
@@ -87,7 +89,7 @@ public:
 
 private:
   /// The write stream socket
-  stream_socket& write_sock_;
+  Stream& write_sock_;
   /// The write buffer
   const buffer::buffer_ref write_buffer_;
   /// The user handler to be executed
@@ -99,13 +101,13 @@ private:
  * A composed asynchronous operation to write
  * exact number of bytes to the socket stream.
  */
-template <typename Handler>
+template <typename Handler, typename Stream = stream_socket>
           // typename CompletionHandler
 class composed_write_op
 {
 public:
   ///
-  composed_write_op(stream_socket& sock,
+  composed_write_op(Stream& sock,
                    //TODO: Ouch!! Specialized buffer!
                    buffer::buffer_ref& buf,
                    Handler&& h)
@@ -185,7 +187,7 @@ public:
 
 private:
   /// The write stream socket
-  stream_socket& write_sock_;
+  Stream& write_sock_;
   /// The write buffer.
   /// NOTE: Not a const because of the `consume`` method
   buffer::buffer_ref& write_buffer_;
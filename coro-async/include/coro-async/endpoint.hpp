@@ -19,26 +19,67 @@
   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
   SOFTWARE.
 */
-
 #ifndef CORO_ASYNC_ENDPOINT_HPP
 #define CORO_ASYNC_ENDPOINT_HPP
 
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <sys/socket.h>
 #include "coro-async/ip_address.hpp"
 
 namespace coro_async {
 
 /**
  * Represents a TCP endpoint.
- * NOTE: Only IPv4 for now.
+ * Holds the native socket address of either family
+ * inline so that it can be passed to the socket calls
+ * without any conversion.
  */
 class endpoint
 {
 public:
+  /// The unspecified IPv4 endpoint (0.0.0.0:0).
+  endpoint() noexcept
+  {
+    ::memset(&data_, 0, sizeof(data_));
+    data_.v4_.sin_family = AF_INET;
+  }
+
   ///Endpoint constructor for v4
-  explicit endpoint(v4_address addr, unsigned short port)
-    : address_(addr)
-    , port_(port)
+  explicit endpoint(v4_address addr, unsigned short port) noexcept
   {
+    ::memset(&data_, 0, sizeof(data_));
+    data_.v4_.sin_family = AF_INET;
+    data_.v4_.sin_addr = addr.native_addr();
+    data_.v4_.sin_port = ::htons(port);
+  }
+
+  ///Endpoint constructor for v6
+  explicit endpoint(v6_address addr, unsigned short port) noexcept
+  {
+    ::memset(&data_, 0, sizeof(data_));
+    data_.v6_.sin6_family = AF_INET6;
+    data_.v6_.sin6_addr = addr.native_addr();
+    data_.v6_.sin6_scope_id = addr.scope_id();
+    data_.v6_.sin6_port = ::htons(port);
+  }
+
+  ///Endpoint constructor for either family
+  explicit endpoint(const ip_address& addr, unsigned short port) noexcept
+    : endpoint()
+  {
+    if (addr.is_v4()) *this = endpoint{addr.to_v4(), port};
+    else              *this = endpoint{addr.to_v6(), port};
+  }
+
+  /// Construct from the native socket address
+  /// as returned by `accept` or `getpeername`.
+  explicit endpoint(const sockaddr* addr, socklen_t len) noexcept
+    : endpoint()
+  {
+    if (len > sizeof(data_)) len = sizeof(data_);
+    ::memcpy(&data_, addr, len);
   }
 
   // Default copy construction
@@ -50,27 +91,110 @@ public:
   endpoint& operator=(endpoint&&)      = default;
 
 public:
+  /// The address family (AF_INET or AF_INET6)
+  int family() const noexcept
+  {
+    return data_.base_.sa_family;
+  }
+
+  ///
+  bool is_v4() const noexcept
+  {
+    return family() == AF_INET;
+  }
+
+  ///
+  bool is_v6() const noexcept
+  {
+    return family() == AF_INET6;
+  }
+
   /// Get the endpoint address
-  v4_address address() const noexcept
+  ip_address address() const noexcept
   {
-    return address_;
+    if (is_v4()) return v4_address{data_.v4_.sin_addr};
+    return v6_address{data_.v6_.sin6_addr, data_.v6_.sin6_scope_id};
   }
 
   /// Get the endpoint port
   unsigned short port() const noexcept
   {
-    return port_;
+    return ::ntohs(is_v4() ? data_.v4_.sin_port : data_.v6_.sin6_port);
+  }
+
+  /// The native socket address
+  const sockaddr* data() const noexcept
+  {
+    return &data_.base_;
+  }
+
+  /// Size of the native socket address
+  socklen_t size() const noexcept
+  {
+    return is_v4() ? sizeof(sockaddr_in) : sizeof(sockaddr_in6);
+  }
+
+  /// Endpoints are equal if both address and port match
+  friend bool operator==(const endpoint& a, const endpoint& b) noexcept
+  {
+    return a.family() == b.family() &&
+           a.port() == b.port() &&
+           a.address() == b.address();
+  }
+
+  friend bool operator!=(const endpoint& a, const endpoint& b) noexcept
+  {
+    return !(a == b);
   }
 
 private:
-  /// The endpoint address
-  //ATTN: Variant for other kinds of addresses
-  v4_address address_;
-  /// Endpoint port
-  unsigned short port_;
+  /// The native socket address
+  union
+  {
+    sockaddr base_;
+    sockaddr_in v4_;
+    sockaddr_in6 v6_;
+  } data_;
 };
 
 }
 
+/**
+ * Hashing support so that endpoints can be used as
+ * keys in unordered containers.
+ * Hashes the same fields `operator==` compares, not the
+ * raw socket address (padding, sin6_flowinfo).
+ */
+namespace std {
+
+  template <>
+  struct hash<coro_async::endpoint>
+  {
+    size_t operator()(const coro_async::endpoint& ep) const noexcept
+    {
+      size_t h = std::hash<int>{}(ep.family());
+      auto combine = [&h](size_t v) {
+        h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+      };
+      combine(ep.port());
+
+      const auto addr = ep.address();
+      if (addr.is_v4())
+      {
+        combine(addr.to_v4().native_addr().s_addr);
+      }
+      else
+      {
+        const auto v6 = addr.to_v6();
+        const in6_addr raw = v6.native_addr();
+        combine(std::hash<std::string_view>{}(
+              std::string_view{reinterpret_cast<const char*>(&raw), sizeof(raw)}));
+        combine(v6.scope_id());
+      }
+      return h;
+    }
+  };
+
+} // END namespace std
 
 #endif
@@ -2,6 +2,7 @@
 #define CORO_ASYNC_ERROR_CODES_HPP
 
 #include <cstring>
+#include <netdb.h>
 #include <system_error>
 
 namespace coro_async {
@@ -50,6 +51,26 @@ struct address_error_category: std::error_category
 
 const address_error_category theAddressErrorCat{};
 
+/**
+ */
+struct resolver_error_category: std::error_category
+{
+  const char* name() const noexcept override
+  {
+    return "resolver_error";
+  }
+
+  /**
+   * NOTE: ev is the EAI_* code returned by getaddrinfo
+   */
+  std::string message(int ev) const override
+  {
+    return ::gai_strerror(ev);
+  }
+};
+
+const resolver_error_category theResolverErrorCat{};
+
 } // END namespace error
 } // END namespace coro-async
 
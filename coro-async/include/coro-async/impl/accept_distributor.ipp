@@ -0,0 +1,216 @@
+#ifndef CORO_ASYNC_ACCEPT_DISTRIBUTOR_IPP
+#define CORO_ASYNC_ACCEPT_DISTRIBUTOR_IPP
+
+#include <cerrno>
+#include <limits>
+#include <algorithm>
+#include <cassert>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "coro-async/detail/socket_ops.hpp"
+
+namespace coro_async {
+
+inline accept_distributor::accept_distributor(
+    std::vector<tcp_acceptor*> acceptors,
+    std::vector<io_service*> shards,
+    options opts)
+  : opts_(opts)
+  , last_sample_(clock_type::now())
+{
+  assert (!acceptors.empty() && "Need atleast one acceptor");
+  assert (!shards.empty() && "Need atleast one shard");
+  assert (opts_.max_accepts_per_event > 0);
+
+  shards_.reserve(shards.size());
+  for (auto ios : shards)
+  {
+    auto s = std::make_unique<shard_load>();
+    s->ios_ = ios;
+    s->last_idle_ = ios->idle_time();
+    shards_.push_back(std::move(s));
+  }
+
+  accepts_.reserve(acceptors.size());
+  for (auto acc : acceptors)
+  {
+    assert (acc->is_open());
+    accepts_.emplace_back(new accept_loop{*this, *acc});
+  }
+}
+
+inline void accept_distributor::start(handler_type handler)
+{
+  handler_ = std::move(handler);
+  for (auto& loop : accepts_)
+  {
+    loop->acceptor_.start_accept_op(loop.get());
+  }
+}
+
+inline void accept_distributor::accept_loop::complete(
+    detail::operation_base* op,
+    const std::error_code& ec,
+    size_t bytes_xferred)
+{
+  (void)bytes_xferred;
+  auto self = static_cast<accept_loop*>(op);
+  if (ec)
+  {
+    self->ec_ = ec;
+    return;
+  }
+  self->owner_.on_readable(*self);
+}
+
+inline void accept_distributor::on_readable(accept_loop& loop)
+{
+  const int lfd = loop.acceptor_.get_native_handle();
+
+  for (size_t i = 0; i < opts_.max_accepts_per_event; i++)
+  {
+    std::error_code ec{};
+    auto res = detail::posix_socket_ops::accept(lfd, ec);
+    if (!ec)
+    {
+      dispatch(pick_shard(res.first), res.first);
+      continue;
+    }
+
+    switch (ec.value())
+    {
+      case EAGAIN:
+#if EAGAIN != EWOULDBLOCK
+      case EWOULDBLOCK:
+#endif
+        loop.acceptor_.start_accept_op(&loop);
+        return;
+
+      // The connection went away before it was accepted
+      case EINTR:
+      case ECONNABORTED:
+      case EPROTO:
+        continue;
+
+      // Out of descriptors or memory, back off for a bit
+      case EMFILE:
+      case ENFILE:
+      case ENOBUFS:
+      case ENOMEM:
+        loop.acceptor_.get_io_service().schedule_after(
+            std::chrono::milliseconds(10),
+            [&loop]() { loop.acceptor_.start_accept_op(&loop); });
+        return;
+
+      default:
+        loop.ec_ = ec;
+        return;
+    };
+  }
+
+  // Batch used up. Re-arming reports what is still pending.
+  loop.acceptor_.start_accept_op(&loop);
+}
+
+inline size_t accept_distributor::pick_shard(int fd)
+{
+  const size_t n = shards_.size();
+  size_t s = 0;
+
+  switch (opts_.balance)
+  {
+    case policy::incoming_cpu:
+    {
+      std::error_code ec{};
+      int cpu = detail::posix_socket_ops::get_option(fd, SOL_SOCKET, SO_INCOMING_CPU, ec);
+      if (!ec && cpu >= 0)
+      {
+        s = static_cast<size_t>(cpu) % n;
+        break;
+      }
+      s = least_connections(std::numeric_limits<uint32_t>::max());
+      break;
+    }
+    case policy::least_utilization:
+    {
+      maybe_sample();
+
+      uint32_t min_util = std::numeric_limits<uint32_t>::max();
+      for (auto& sh : shards_)
+      {
+        min_util = std::min(min_util, sh->utilization_.load(std::memory_order_relaxed));
+      }
+      s = least_connections(min_util + static_cast<uint32_t>(opts_.utilization_slack * 1000));
+      break;
+    }
+    case policy::least_connections:
+    default:
+      s = least_connections(std::numeric_limits<uint32_t>::max());
+      break;
+  };
+
+  shards_[s]->active_.fetch_add(1, std::memory_order_relaxed);
+  return s;
+}
+
+inline size_t accept_distributor::least_connections(uint32_t max_util) const noexcept
+{
+  const size_t n = shards_.size();
+  // Start the scan at a rotating shard so that ties
+  // are spread out instead of all going to shard 0.
+  const size_t start = next_.fetch_add(1, std::memory_order_relaxed) % n;
+
+  size_t best = start;
+  size_t best_active = std::numeric_limits<size_t>::max();
+
+  for (size_t i = 0; i < n; i++)
+  {
+    const size_t id = (start + i) % n;
+    auto& sh = *shards_[id];
+    if (sh.utilization_.load(std::memory_order_relaxed) > max_util) continue;
+
+    const size_t active = sh.active_.load(std::memory_order_relaxed);
+    if (active < best_active)
+    {
+      best = id;
+      best_active = active;
+    }
+  }
+  return best;
+}
+
+inline void accept_distributor::maybe_sample()
+{
+  // Some other acceptor thread is at it
+  std::unique_lock<std::mutex> lk{sample_lock_, std::try_to_lock};
+  if (!lk.owns_lock()) return;
+
+  const auto now = clock_type::now();
+  const auto wall = now - last_sample_;
+  if (wall < opts_.sample_interval) return;
+
+  const double wall_ns = std::chrono::duration<double, std::nano>(wall).count();
+  for (auto& sh : shards_)
+  {
+    const auto idle = sh->ios_->idle_time();
+    const double idle_ns = std::chrono::duration<double, std::nano>(idle - sh->last_idle_).count();
+    sh->last_idle_ = idle;
+
+    double util = 1.0 - idle_ns / wall_ns;
+    if (util < 0.0) util = 0.0;
+    if (util > 1.0) util = 1.0;
+    sh->utilization_.store(static_cast<uint32_t>(util * 1000), std::memory_order_relaxed);
+  }
+  last_sample_ = now;
+}
+
+inline void accept_distributor::dispatch(size_t shard, int fd)
+{
+  // The accept loop only carries on once the handler has
+  // returned, so on the accepting shard it is run inline.
+  shards_[shard]->ios_->dispatch([this, shard, fd]() { handler_(shard, fd); });
+}
+
+} // END namespace coro_async
+
+#endif
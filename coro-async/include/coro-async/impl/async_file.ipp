@@ -0,0 +1,146 @@
+#ifndef CORO_ASYNC_ASYNC_FILE_IPP
+#define CORO_ASYNC_ASYNC_FILE_IPP
+
+#include <cerrno>
+#include <memory>
+#include <type_traits>
+
+extern "C" {
+  #include <fcntl.h>
+  #include <unistd.h>
+}
+
+namespace coro_async {
+
+inline void async_file::close() noexcept
+{
+  if (fd_ != -1) ::close(fd_);
+  fd_ = -1;
+}
+
+template <typename Fn, typename Handler>
+void async_file::run_blocking(Fn&& fn, Handler&& h)
+{
+  using handler_type = typename std::decay_t<Handler>;
+
+  pool_.post([&ios = ios_,
+              fn{std::forward<Fn>(fn)},
+              handler{handler_type{std::forward<Handler>(h)}}]() mutable
+             {
+               std::error_code ec{};
+               size_t n = fn(ec);
+               ios.post([ec, n, handler{std::move(handler)}]() mutable
+                        {
+                          handler(ec, n);
+                        });
+             });
+}
+
+template <typename Handler>
+void async_file::async_open(std::string path, int flags, mode_t mode, Handler&& h)
+{
+  using handler_type = typename std::decay_t<Handler>;
+
+  assert (!is_open());
+
+  // The descriptor is handed over to `this` on the io_service
+  // thread, so a concurrent `get_native_handle` never races.
+  auto fd = std::make_shared<int>(-1);
+
+  run_blocking(
+      [path{std::move(path)}, flags, mode, fd](std::error_code& ec) -> size_t
+      {
+        do {
+          *fd = ::open(path.c_str(), flags | O_CLOEXEC, mode);
+        } while (*fd == -1 && errno == EINTR);
+
+        if (*fd == -1) ec = std::error_code{errno, std::system_category()};
+        return 0;
+      },
+      [this, fd, handler{handler_type{std::forward<Handler>(h)}}]
+      (const std::error_code& ec, size_t n) mutable
+      {
+        if (!ec) fd_ = *fd;
+        handler(ec, n);
+      });
+}
+
+template <typename Handler>
+void async_file::async_pread(buffer::buffer_ref buf, off_t offset, Handler&& h)
+{
+  assert (is_open());
+
+  run_blocking(
+      [fd = fd_, data = buf.data(), len = buf.size(), offset](std::error_code& ec) -> size_t
+      {
+        while (true)
+        {
+          ssize_t rbytes = ::pread(fd, data, len, offset);
+          if (rbytes >= 0) return rbytes;
+          if (errno == EINTR) continue;
+
+          ec = std::error_code{errno, std::system_category()};
+          return 0;
+        }
+      },
+      std::forward<Handler>(h));
+}
+
+template <typename Handler>
+void async_file::async_pwrite(buffer::buffer_ref buf, off_t offset, Handler&& h)
+{
+  assert (is_open());
+
+  run_blocking(
+      [fd = fd_, data = buf.data(), len = buf.size(), offset](std::error_code& ec) -> size_t
+      {
+        size_t written = 0;
+        while (written < len)
+        {
+          ssize_t wbytes = ::pwrite(fd, data + written, len - written, offset + written);
+          if (wbytes >= 0)
+          {
+            written += wbytes;
+            continue;
+          }
+          if (errno == EINTR) continue;
+
+          ec = std::error_code{errno, std::system_category()};
+          break;
+        }
+        return written;
+      },
+      std::forward<Handler>(h));
+}
+
+template <typename Handler>
+void async_file::async_fsync(Handler&& h)
+{
+  assert (is_open());
+
+  run_blocking(
+      [fd = fd_](std::error_code& ec) -> size_t
+      {
+        if (::fsync(fd) != 0) ec = std::error_code{errno, std::system_category()};
+        return 0;
+      },
+      std::forward<Handler>(h));
+}
+
+template <typename Handler>
+void async_file::async_fdatasync(Handler&& h)
+{
+  assert (is_open());
+
+  run_blocking(
+      [fd = fd_](std::error_code& ec) -> size_t
+      {
+        if (::fdatasync(fd) != 0) ec = std::error_code{errno, std::system_category()};
+        return 0;
+      },
+      std::forward<Handler>(h));
+}
+
+} // END namespace coro_async
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef CORO_ASYNC_CPU_TOPOLOGY_IPP
+#define CORO_ASYNC_CPU_TOPOLOGY_IPP
+
+#include <cerrno>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+extern "C" {
+  #include <sched.h>
+  #include <dirent.h>
+  #include <pthread.h>
+  #include <unistd.h>
+  #include <sys/syscall.h>
+}
+
+namespace coro_async {
+
+inline cpu_topology::cpu_topology(const std::string& root)
+{
+  DIR* dir = ::opendir(root.c_str());
+  if (dir)
+  {
+    while (auto ent = ::readdir(dir))
+    {
+      const std::string name = ent->d_name;
+      if (name.compare(0, 4, "node") != 0 || name.size() == 4) continue;
+      if (!std::all_of(name.begin() + 4, name.end(), ::isdigit)) continue;
+
+      std::ifstream in{root + "/" + name + "/cpulist"};
+      std::string list;
+      if (!std::getline(in, list)) continue;
+
+      node n;
+      n.id_ = std::atoi(name.c_str() + 4);
+      n.cpus_ = parse_cpu_list(list);
+      // Memory only nodes do not run loops
+      if (n.cpus_.empty()) continue;
+
+      num_cpus_ += n.cpus_.size();
+      nodes_.push_back(std::move(n));
+    }
+    ::closedir(dir);
+  }
+
+  if (nodes_.empty())
+  {
+    load_flat();
+    return;
+  }
+
+  std::sort(nodes_.begin(), nodes_.end(),
+            [](const node& a, const node& b) { return a.id_ < b.id_; });
+}
+
+inline const cpu_topology& cpu_topology::system()
+{
+  static const cpu_topology topo{};
+  return topo;
+}
+
+inline void cpu_topology::load_flat()
+{
+  node n;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+
+  if (::sched_getaffinity(0, sizeof(set), &set) == 0)
+  {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+      if (CPU_ISSET(cpu, &set)) n.cpus_.push_back(cpu);
+    }
+  }
+  if (n.cpus_.empty()) n.cpus_.push_back(0);
+
+  num_cpus_ = n.cpus_.size();
+  nodes_.push_back(std::move(n));
+}
+
+inline int cpu_topology::node_of(int cpu) const noexcept
+{
+  for (size_t i = 0; i < nodes_.size(); i++)
+  {
+    const auto& cpus = nodes_[i].cpus_;
+    if (std::binary_search(cpus.begin(), cpus.end(), cpu)) return static_cast<int>(i);
+  }
+  return -1;
+}
+
+inline std::vector<int> cpu_topology::pick_cpus(size_t n) const
+{
+  std::vector<int> all;
+  all.reserve(num_cpus_);
+  for (const auto& nd : nodes_)
+  {
+    all.insert(all.end(), nd.cpus_.begin(), nd.cpus_.end());
+  }
+
+  std::vector<int> res;
+  res.reserve(n);
+  for (size_t i = 0; i < n; i++)
+  {
+    res.push_back(all[i % all.size()]);
+  }
+  return res;
+}
+
+inline std::vector<int> cpu_topology::parse_cpu_list(const std::string& list)
+{
+  std::vector<int> cpus;
+  std::istringstream in{list};
+  std::string range;
+
+  while (std::getline(in, range, ','))
+  {
+    if (range.empty() || !::isdigit(static_cast<unsigned char>(range[0]))) continue;
+
+    char* end = nullptr;
+    const long first = std::strtol(range.c_str(), &end, 10);
+    long last = first;
+    if (*end == '-') last = std::strtol(end + 1, nullptr, 10);
+
+    for (long cpu = first; cpu <= last; cpu++)
+    {
+      cpus.push_back(static_cast<int>(cpu));
+    }
+  }
+
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+inline void cpu_topology::pin_this_thread(int cpu, std::error_code& ec)
+{
+  ec.clear();
+
+  if (cpu < 0 || cpu >= CPU_SETSIZE)
+  {
+    ec = std::error_code{EINVAL, std::system_category()};
+    return;
+  }
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+
+  int rc = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+  if (rc != 0)
+  {
+    ec = std::error_code{rc, std::system_category()};
+  }
+}
+
+inline void cpu_topology::bind_memory(void* addr, size_t len, int node_id, std::error_code& ec)
+{
+  ec.clear();
+
+#ifdef SYS_mbind
+  // From <numaif.h>, not included to not depend on libnuma
+  constexpr int mpol_preferred = 1;
+  constexpr size_t mask_bits = 1024;
+
+  if (node_id < 0 || static_cast<size_t>(node_id) >= mask_bits)
+  {
+    ec = std::error_code{EINVAL, std::system_category()};
+    return;
+  }
+
+  unsigned long mask[mask_bits / (8 * sizeof(unsigned long))] = {0,};
+  mask[node_id / (8 * sizeof(unsigned long))] |= 1UL << (node_id % (8 * sizeof(unsigned long)));
+
+  long rc = ::syscall(SYS_mbind, addr, len, mpol_preferred, mask, mask_bits + 1, 0);
+  if (rc != 0 && errno != ENOSYS)
+  {
+    ec = std::error_code{errno, std::system_category()};
+  }
+#else
+  (void)addr;
+  (void)len;
+  (void)node_id;
+#endif
+}
+
+} // END namespace coro_async
+
+#endif
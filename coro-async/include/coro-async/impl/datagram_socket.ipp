@@ -0,0 +1,49 @@
+#ifndef CORO_ASYNC_DATAGRAM_SOCKET_IPP
+#define CORO_ASYNC_DATAGRAM_SOCKET_IPP
+
+#include "coro-async/error_codes.hpp"
+#include "coro-async/detail/reactor_ops.hpp"
+#include "coro-async/detail/datagram_op.hpp"
+
+namespace coro_async {
+
+template <typename ReadHandler>
+void datagram_socket::async_receive_batch(datagram_batch& batch, ReadHandler&& rh)
+{
+  using handler_type = typename std::decay_t<ReadHandler>;
+
+  assert (is_open() && "Receive on an unbound datagram socket");
+
+  auto op = new detail::recv_batch_op<handler_type>{
+                 *this, batch, std::forward<ReadHandler>(rh)};
+  start_reactor_op(reactor_ops::read_op, op);
+
+  return;
+}
+
+template <typename WriteHandler>
+void datagram_socket::async_send_batch(datagram_batch& batch, WriteHandler&& wh)
+{
+  using handler_type = typename std::decay_t<WriteHandler>;
+
+  assert (is_open() && "Send on an unopened datagram socket");
+
+  if (batch.empty())
+  {
+    ios_.post([handler{handler_type{std::forward<WriteHandler>(wh)}}]() mutable
+              {
+                handler(std::error_code{}, 0);
+              });
+    return;
+  }
+
+  auto op = new detail::send_batch_op<handler_type>{
+                 *this, batch, std::forward<WriteHandler>(wh)};
+  start_reactor_op(reactor_ops::write_op, op);
+
+  return;
+}
+
+} // END namespace coro-async
+
+#endif
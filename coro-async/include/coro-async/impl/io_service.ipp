@@ -7,21 +7,107 @@
 namespace coro_async {
 
 template <typename Handler>
-void io_service::post(Handler&& h)
+void io_executor::post(Handler&& h, priority prio)
 {
   using handler_type = typename std::decay_t<Handler>;
 
-  auto op = new detail::scheduler_op<handler_type>{std::forward<Handler>(h)};
-  scheduler_.post(op);
+  auto op = new detail::scheduler_op<handler_type>{handler_type{std::forward<Handler>(h)}};
+  post_op(op, prio);
 }
 
-void io_service::run()
+template <typename Handler>
+void io_executor::defer(Handler&& h)
+{
+  using handler_type = typename std::decay_t<Handler>;
+
+  auto op = new detail::scheduler_op<handler_type>{handler_type{std::forward<Handler>(h)}};
+  defer_op(op);
+}
+
+template <typename Threading>
+template <typename Handler>
+void basic_io_service<Threading>::post(Handler&& h, priority prio)
+{
+  using handler_type = typename std::decay_t<Handler>;
+
+  auto op = new detail::scheduler_op<handler_type>{handler_type{std::forward<Handler>(h)}};
+  scheduler_.post(op, prio);
+}
+
+template <typename Threading>
+template <typename Handler>
+void basic_io_service<Threading>::dispatch(Handler&& h, priority prio)
 {
-  while ( true )
+  if (running_in_this_thread())
   {
-    std::error_code ec{};
-    scheduler_.run(ec);
+    h();
+    return;
   }
+  post(std::forward<Handler>(h), prio);
+}
+
+template <typename Threading>
+template <typename Handler>
+void basic_io_service<Threading>::defer(Handler&& h)
+{
+  using handler_type = typename std::decay_t<Handler>;
+
+  auto op = new detail::scheduler_op<handler_type>{handler_type{std::forward<Handler>(h)}};
+  scheduler_.defer_op(op);
+}
+
+template <typename Threading>
+basic_io_service<Threading>::run_scope::run_scope(basic_io_service& ios) noexcept
+  : prev_(current_)
+{
+  current_ = &ios;
+}
+
+template <typename Threading>
+basic_io_service<Threading>::run_scope::~run_scope()
+{
+  current_ = prev_;
+}
+
+template <typename Threading>
+size_t basic_io_service<Threading>::run()
+{
+  run_scope scope{*this};
+  std::error_code ec{};
+  return scheduler_.run(ec);
+}
+
+template <typename Threading>
+size_t basic_io_service<Threading>::run_one()
+{
+  run_scope scope{*this};
+  std::error_code ec{};
+  return scheduler_.run_one(ec);
+}
+
+template <typename Threading>
+size_t basic_io_service<Threading>::poll()
+{
+  run_scope scope{*this};
+  std::error_code ec{};
+  return scheduler_.poll(ec);
+}
+
+template <typename Threading>
+size_t basic_io_service<Threading>::poll_one()
+{
+  run_scope scope{*this};
+  std::error_code ec{};
+  return scheduler_.poll_one(ec);
+}
+
+template <typename Threading>
+template <typename Rep, typename Period>
+size_t basic_io_service<Threading>::run_for(const std::chrono::duration<Rep, Period>& dur)
+{
+  run_scope scope{*this};
+  std::error_code ec{};
+  return scheduler_.run_for(dur, ec);
 }
 
 } // END namespace coro_async
@@ -0,0 +1,74 @@
+#ifndef CORO_ASYNC_POSIX_STREAM_DESCRIPTOR_IPP
+#define CORO_ASYNC_POSIX_STREAM_DESCRIPTOR_IPP
+
+#include "coro-async/detail/read_op.hpp"
+#include "coro-async/detail/write_op.hpp"
+#include "coro-async/detail/reactor_ops.hpp"
+
+namespace coro_async {
+
+template <typename Buffer, typename ReadHandler>
+void posix_stream_descriptor::async_read_some(const Buffer& buf, ReadHandler&& rh)
+{
+  using handler_type = typename std::decay_t<ReadHandler>;
+
+  assert (is_open() && "No descriptor assigned");
+
+  auto op = new detail::read_op<handler_type, posix_stream_descriptor>{
+                 *this, buf, std::forward<ReadHandler>(rh)};
+  start_reactor_op(reactor_ops::read_op, op);
+
+  return;
+}
+
+template <typename ReadHandler>
+void posix_stream_descriptor::async_read(buffer::buffer_ref& buf, ReadHandler&& rh)
+{
+  using handler_type = typename std::decay_t<ReadHandler>;
+  using composed_type = detail::composed_read_op<handler_type, posix_stream_descriptor>;
+
+  assert (is_open() && "No descriptor assigned");
+
+  auto op = new detail::read_op<composed_type, posix_stream_descriptor>{
+                 *this, buf,
+                 composed_type{*this, buf, std::forward<ReadHandler>(rh)}};
+
+  start_reactor_op(reactor_ops::read_op, op);
+
+  return;
+}
+
+template <typename Buffer, typename WriteHandler>
+void posix_stream_descriptor::async_write_some(const Buffer& buf, WriteHandler&& wh)
+{
+  using handler_type = typename std::decay_t<WriteHandler>;
+
+  assert (is_open() && "No descriptor assigned");
+
+  auto op = new detail::write_op<handler_type, posix_stream_descriptor>{
+                 *this, buf, std::forward<WriteHandler>(wh)};
+  start_reactor_op(reactor_ops::write_op, op);
+
+  return;
+}
+
+template <typename WriteHandler>
+void posix_stream_descriptor::async_write(buffer::buffer_ref& buf, WriteHandler&& wh)
+{
+  using handler_type = typename std::decay_t<WriteHandler>;
+  using composed_type = detail::composed_write_op<handler_type, posix_stream_descriptor>;
+
+  assert (is_open() && "No descriptor assigned");
+
+  auto op = new detail::write_op<composed_type, posix_stream_descriptor>{
+                 *this, buf,
+                 composed_type{*this, buf, std::forward<WriteHandler>(wh)}};
+
+  start_reactor_op(reactor_ops::write_op, op);
+
+  return;
+}
+
+} // END namespace coro-async
+
+#endif
@@ -0,0 +1,345 @@
+#ifndef CORO_ASYNC_RESOLVER_IPP
+#define CORO_ASYNC_RESOLVER_IPP
+
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+extern "C" {
+  #include <netdb.h>
+  #include <sys/types.h>
+  #include <sys/socket.h>
+  #include <arpa/inet.h>
+}
+
+namespace coro_async {
+
+namespace detail {
+
+/// Host names are case insensitive
+inline std::string lower_case(std::string name)
+{
+  std::transform(name.begin(), name.end(), name.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return name;
+}
+
+} // END namespace detail
+
+inline resolver::resolver(io_service& ios, options opts)
+  : ios_(ios)
+  , opts_(std::move(opts))
+{
+  if (!opts_.hosts_file.empty())
+  {
+    load_hosts(opts_.hosts_file);
+  }
+
+  queries_->owner_ = this;
+  const size_t n = opts_.lookup_threads ? opts_.lookup_threads : 1;
+  for (size_t i = 0; i < n; i++)
+  {
+    std::thread{query_loop, queries_, opts_.family}.detach();
+  }
+}
+
+inline resolver::~resolver()
+{
+  {
+    std::lock_guard<std::mutex> guard{queries_->lock_};
+    queries_->owner_ = nullptr;
+  }
+  queries_->event_.notify_all();
+
+  // The lookups still waiting on a query complete with an error
+  const std::error_code ec{ECANCELED, std::system_category()};
+  for (auto& kv : waiters_)
+  {
+    for (auto& w : kv.second)
+    {
+      ios_.post([ec, handler{std::move(w.handler_)}]() mutable
+                {
+                  handler(ec, results_type{});
+                });
+    }
+  }
+}
+
+template <typename ResolveHandler>
+void resolver::async_resolve(std::string host, uint16_t port, ResolveHandler&& rh)
+{
+  using handler_type = typename std::decay_t<ResolveHandler>;
+
+  host = detail::lower_case(std::move(host));
+
+  results_type res{};
+  std::error_code ec{};
+  if (try_resolve_normalized(host, port, res, ec))
+  {
+    ios_.post([ec, res{std::move(res)}, handler{handler_type{std::forward<ResolveHandler>(rh)}}]() mutable
+              {
+                handler(ec, std::move(res));
+              });
+    return;
+  }
+
+  waiters_[host].push_back({ port, std::forward<ResolveHandler>(rh) });
+
+  auto& entry = cache_[host];
+  if (!entry.querying_)
+  {
+    start_query(host);
+  }
+}
+
+inline bool resolver::try_resolve(const std::string& host, uint16_t port,
+                                  results_type& res, std::error_code& ec)
+{
+  return try_resolve_normalized(detail::lower_case(host), port, res, ec);
+}
+
+inline bool resolver::try_resolve_normalized(const std::string& host, uint16_t port,
+                                             results_type& res, std::error_code& ec)
+{
+  ec.clear();
+  res.clear();
+
+  // Numeric address
+  ip_address addr;
+  if (ip_address::from_string(host, addr))
+  {
+    res.push_back(endpoint{addr, port});
+    return true;
+  }
+
+  auto hit = hosts_.find(host);
+  if (hit != hosts_.end())
+  {
+    res = to_endpoints(hit->second, port);
+    return true;
+  }
+
+  auto it = cache_.find(host);
+  if (it == cache_.end())
+  {
+    return false;
+  }
+
+  auto& entry = it->second;
+  const auto now = clock_type::now();
+
+  // First lookup still in flight
+  if (entry.addrs_.empty() && !entry.ec_)
+  {
+    return false;
+  }
+
+  if (now < entry.expires_)
+  {
+    if (entry.ec_)
+    {
+      ec = entry.ec_;
+      return true;
+    }
+    res = to_endpoints(entry.addrs_, port);
+    return true;
+  }
+
+  // Serve a stale answer while it gets refreshed
+  if (!entry.ec_ && now < entry.expires_ + opts_.stale_ttl)
+  {
+    res = to_endpoints(entry.addrs_, port);
+    if (!entry.querying_)
+    {
+      start_query(host);
+    }
+    return true;
+  }
+
+  return false;
+}
+
+inline resolver::results_type
+resolver::to_endpoints(const addresses_type& addrs, uint16_t port)
+{
+  results_type res;
+  res.reserve(addrs.size());
+  for (const auto& a : addrs)
+  {
+    res.push_back(endpoint{a, port});
+  }
+  return res;
+}
+
+inline void resolver::load_hosts(const std::string& path)
+{
+  std::ifstream hosts{path};
+  std::string line;
+
+  while (std::getline(hosts, line))
+  {
+    auto comment = line.find('#');
+    if (comment != std::string::npos) line.erase(comment);
+
+    std::istringstream tokens{line};
+    std::string ip;
+    if (!(tokens >> ip)) continue;
+
+    ip_address addr;
+    if (!ip_address::from_string(ip, addr)) continue;
+    if (!family_allowed(addr)) continue;
+
+    std::string name;
+    while (tokens >> name)
+    {
+      hosts_[detail::lower_case(name)].push_back(addr);
+    }
+  }
+}
+
+inline bool resolver::family_allowed(const ip_address& addr) const noexcept
+{
+  if (opts_.family == AF_INET)  return addr.is_v4();
+  if (opts_.family == AF_INET6) return addr.is_v6();
+  return true;
+}
+
+inline void resolver::start_query(const std::string& host)
+{
+  cache_[host].querying_ = true;
+  {
+    std::lock_guard<std::mutex> guard{queries_->lock_};
+    queries_->names_.push_back(host);
+  }
+  queries_->event_.notify_one();
+}
+
+inline void resolver::post_answer(std::string host, addresses_type addrs, std::error_code ec)
+{
+  std::weak_ptr<bool> alive = alive_;
+  ios_.post([this, alive, host{std::move(host)}, addrs{std::move(addrs)}, ec]() mutable
+            {
+              if (alive.expired()) return;
+              this->on_query_done(host, std::move(addrs), ec);
+            });
+}
+
+inline void resolver::on_query_done(const std::string& host,
+                                    addresses_type addrs,
+                                    std::error_code ec)
+{
+  auto& entry = cache_[host];
+  entry.querying_ = false;
+  const auto now = clock_type::now();
+
+  if (!ec)
+  {
+    entry.addrs_ = std::move(addrs);
+    entry.ec_.clear();
+    entry.expires_ = now + opts_.ttl;
+  }
+  else if (entry.ec_ || entry.addrs_.empty() ||
+           now >= entry.expires_ + opts_.stale_ttl)
+  {
+    entry.addrs_.clear();
+    entry.ec_ = ec;
+    entry.expires_ = now + opts_.negative_ttl;
+  }
+  // else: Refresh failed, keep serving the stale answer.
+
+  auto it = waiters_.find(host);
+  if (it == waiters_.end()) return;
+
+  auto waiting = std::move(it->second);
+  waiters_.erase(it);
+
+  // The handlers may start new lookups which could
+  // invalidate `entry`.
+  const auto result_ec = entry.ec_;
+  const auto result_addrs = entry.addrs_;
+
+  for (auto& w : waiting)
+  {
+    if (result_ec) w.handler_(result_ec, results_type{});
+    else           w.handler_(result_ec, to_endpoints(result_addrs, w.port_));
+  }
+}
+
+inline void resolver::query_loop(std::shared_ptr<query_queue> queue, int family)
+{
+  while (true)
+  {
+    std::string host;
+    {
+      std::unique_lock<std::mutex> lk{queue->lock_};
+      queue->event_.wait(lk, [&queue] {
+            return !queue->owner_ || !queue->names_.empty();
+          });
+      if (!queue->owner_) return;
+
+      host = std::move(queue->names_.front());
+      queue->names_.pop_front();
+    }
+
+    std::error_code ec{};
+    auto addrs = do_query(host, family, ec);
+
+    // Under the lock: the resolver (and so its io_service)
+    // can not go away while the answer is being posted.
+    std::lock_guard<std::mutex> guard{queue->lock_};
+    if (!queue->owner_) return;
+    queue->owner_->post_answer(std::move(host), std::move(addrs), ec);
+  }
+}
+
+inline resolver::addresses_type
+resolver::do_query(const std::string& host, int family, std::error_code& ec)
+{
+  ec.clear();
+
+  addrinfo hints;
+  ::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = family;
+  hints.ai_socktype = SOCK_STREAM;
+
+  addrinfo* result = nullptr;
+  int rc = ::getaddrinfo(host.c_str(), nullptr, &hints, &result);
+  if (rc != 0)
+  {
+    if (rc == EAI_SYSTEM) ec = std::error_code{errno, std::system_category()};
+    else                  ec = std::error_code{rc, error::theResolverErrorCat};
+    return {};
+  }
+
+  addresses_type addrs;
+  for (auto ai = result; ai; ai = ai->ai_next)
+  {
+    ip_address a{};
+    if (ai->ai_family == AF_INET)
+    {
+      a = v4_address{reinterpret_cast<sockaddr_in*>(ai->ai_addr)->sin_addr};
+    }
+    else if (ai->ai_family == AF_INET6)
+    {
+      auto sin6 = reinterpret_cast<sockaddr_in6*>(ai->ai_addr);
+      a = v6_address{sin6->sin6_addr, sin6->sin6_scope_id};
+    }
+    else
+    {
+      continue;
+    }
+
+    if (std::find(addrs.begin(), addrs.end(), a) == addrs.end())
+    {
+      addrs.push_back(a);
+    }
+  }
+  ::freeaddrinfo(result);
+
+  return addrs;
+}
+
+} // END namespace coro_async
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef CORO_ASYNC_SHARD_GROUP_IPP
+#define CORO_ASYNC_SHARD_GROUP_IPP
+
+#include <cassert>
+
+namespace coro_async {
+
+inline shard_group::shard_group(size_t n, const cpu_topology& topo, options opts)
+  : opts_(std::move(opts))
+{
+  assert (n > 0 && "Need atleast one shard");
+  if (opts_.cpus.empty()) opts_.cpus = topo.pick_cpus(n);
+  assert (opts_.cpus.size() == n && "Need a CPU per shard");
+
+  slots_.reserve(n);
+  for (size_t i = 0; i < n; i++)
+  {
+    auto s = std::make_unique<slot>();
+    s->cpu_ = opts_.cpus[i];
+    const int node = topo.node_of(s->cpu_);
+    if (node != -1) s->node_id_ = topo.node_id(node);
+    slots_.push_back(std::move(s));
+  }
+}
+
+inline shard_group::~shard_group()
+{
+  stop();
+  join();
+}
+
+inline void shard_group::start(start_fn on_start)
+{
+  for (size_t i = 0; i < slots_.size(); i++)
+  {
+    slots_[i]->thread_ = std::thread{[this, i, on_start] { this->run_shard(i, on_start); }};
+  }
+
+  std::unique_lock<std::mutex> lk{lock_};
+  ready_event_.wait(lk, [this] { return started_ == slots_.size(); });
+}
+
+inline void shard_group::run_shard(size_t id, const start_fn& on_start)
+{
+  auto& s = *slots_[id];
+
+  // Pin before allocating anything, so that first touch
+  // places the memory on the node of the CPU.
+  if (opts_.pin) cpu_topology::pin_this_thread(s.cpu_, s.pin_ec_);
+
+  s.ios_ = std::make_unique<io_service>();
+  if (on_start) on_start(id, *s.ios_);
+
+  {
+    std::lock_guard<std::mutex> guard{lock_};
+    started_++;
+  }
+  ready_event_.notify_all();
+
+  s.ios_->run();
+}
+
+inline void shard_group::stop() noexcept
+{
+  for (auto& s : slots_)
+  {
+    if (s->ios_) s->ios_->stop();
+  }
+}
+
+inline void shard_group::join()
+{
+  for (auto& s : slots_)
+  {
+    if (s->thread_.joinable()) s->thread_.join();
+  }
+}
+
+inline std::vector<io_service*> shard_group::shards() const
+{
+  std::vector<io_service*> res;
+  res.reserve(slots_.size());
+  for (auto& s : slots_)
+  {
+    res.push_back(s->ios_.get());
+  }
+  return res;
+}
+
+} // END namespace coro_async
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef CORO_ASYNC_SHARD_MESH_IPP
+#define CORO_ASYNC_SHARD_MESH_IPP
+
+#include <cassert>
+#include <type_traits>
+#include "coro-async/detail/scheduler_op.hpp"
+
+namespace coro_async {
+
+inline shard_mesh::shard_mesh(std::vector<io_service*> shards, size_t ring_capacity)
+  : shards_(std::move(shards))
+{
+  const size_t n = shards_.size();
+  assert (n > 0 && "Need atleast one shard");
+
+  boxes_.reserve(n * n);
+  for (size_t i = 0; i < n * n; i++)
+  {
+    boxes_.emplace_back(new mailbox{ring_capacity});
+  }
+
+  hooks_.reserve(n);
+  for (size_t id = 0; id < n; id++)
+  {
+    auto h = std::make_unique<shard_hook>();
+    h->mesh_ = this;
+    h->id_ = id;
+    h->hook_.ctx_ = h.get();
+    h->hook_.poll_ = [](void* ctx) -> size_t {
+      auto sh = static_cast<shard_hook*>(ctx);
+      return sh->mesh_->poll(sh->id_);
+    };
+    h->hook_.pending_ = [](void* ctx) -> bool {
+      auto sh = static_cast<shard_hook*>(ctx);
+      return sh->mesh_->pending(sh->id_);
+    };
+    shards_[id]->add_loop_hook(&h->hook_);
+    hooks_.push_back(std::move(h));
+  }
+}
+
+inline shard_mesh::~shard_mesh()
+{
+  for (size_t id = 0; id < shards_.size(); id++)
+  {
+    shards_[id]->remove_loop_hook(&hooks_[id]->hook_);
+  }
+}
+
+template <typename Fn>
+void shard_mesh::submit_to(size_t from, size_t to, Fn&& fn)
+{
+  using handler_type = typename std::decay_t<Fn>;
+
+  auto op = new detail::scheduler_op<handler_type>{handler_type{std::forward<Fn>(fn)}};
+  send(from, to, op);
+}
+
+inline void shard_mesh::send(size_t from, size_t to, detail::operation_base* op)
+{
+  assert (from < size() && to < size());
+
+  if (from == to)
+  {
+    shards_[to]->post_op(op);
+    return;
+  }
+
+  auto& b = box(from, to);
+  // Keep the order: nothing may overtake the overflow
+  if (!b.overflow_.is_empty() || !b.ring_.push(op))
+  {
+    b.overflow_.push(op);
+  }
+  b.unnotified_ = true;
+}
+
+inline size_t shard_mesh::poll(size_t id)
+{
+  const size_t n = size();
+  size_t handled = 0;
+
+  // Receive
+  for (size_t from = 0; from < n; from++)
+  {
+    if (from == id) continue;
+
+    auto& b = box(from, id);
+    detail::operation_base* op = nullptr;
+    while (b.ring_.pop(op))
+    {
+      std::error_code ec{};
+      op->call(op, ec, 0);
+      handled++;
+    }
+  }
+
+  // Send: move the overflow over and wake the receivers,
+  // once for everything sent since the last poll.
+  for (size_t to = 0; to < n; to++)
+  {
+    if (to == id) continue;
+
+    auto& b = box(id, to);
+    // Unlinked before the push: once in the ring the
+    // receiver may run and free it.
+    while (!b.overflow_.is_empty() && !b.ring_.full())
+    {
+      b.ring_.push(b.overflow_.pop());
+      b.unnotified_ = true;
+    }
+
+    if (b.unnotified_)
+    {
+      b.unnotified_ = false;
+      shards_[to]->wake();
+    }
+  }
+
+  return handled;
+}
+
+inline bool shard_mesh::pending(size_t id)
+{
+  const size_t n = size();
+  for (size_t other = 0; other < n; other++)
+  {
+    if (other == id) continue;
+
+    if (!box(other, id).ring_.empty()) return true;
+
+    auto& out = box(id, other);
+    if (out.unnotified_ || !out.overflow_.is_empty()) return true;
+  }
+  return false;
+}
+
+} // END namespace coro_async
+
+#endif
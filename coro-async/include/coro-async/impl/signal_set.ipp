@@ -0,0 +1,162 @@
+#ifndef CORO_ASYNC_SIGNAL_SET_IPP
+#define CORO_ASYNC_SIGNAL_SET_IPP
+
+#include <cerrno>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/signalfd.h>
+
+#include "coro-async/detail/signal_op.hpp"
+#include "coro-async/detail/reactor_ops.hpp"
+#include "coro-async/detail/retire_descriptor.hpp"
+
+namespace coro_async {
+
+inline signal_set::~signal_set()
+{
+  // The pending waits complete with an error
+  detail::retire_descriptor(ios_, reactor_, desc_, desc_state_);
+  clear();
+}
+
+inline bool signal_set::add(int signo, std::error_code& ec)
+{
+  ec.clear();
+  if (contains(signo)) return true;
+
+  sigset_t one;
+  sigemptyset(&one);
+  if (sigaddset(&one, signo) != 0)
+  {
+    ec = std::error_code{errno, std::system_category()};
+    return false;
+  }
+
+  sigset_t old;
+  int rc = ::pthread_sigmask(SIG_BLOCK, &one, &old);
+  if (rc != 0)
+  {
+    ec = std::error_code{rc, std::system_category()};
+    return false;
+  }
+  if (!sigismember(&old, signo)) sigaddset(&blocked_by_us_, signo);
+
+  sigaddset(&signals_, signo);
+  if (!update_signalfd(ec))
+  {
+    std::error_code ignore{};
+    remove(signo, ignore);
+    return false;
+  }
+  return true;
+}
+
+inline bool signal_set::remove(int signo, std::error_code& ec)
+{
+  ec.clear();
+  if (!contains(signo)) return true;
+
+  sigdelset(&signals_, signo);
+  if (desc_.get() != -1 && !update_signalfd(ec)) return false;
+
+  if (sigismember(&blocked_by_us_, signo))
+  {
+    sigdelset(&blocked_by_us_, signo);
+
+    sigset_t one;
+    sigemptyset(&one);
+    sigaddset(&one, signo);
+    int rc = ::pthread_sigmask(SIG_UNBLOCK, &one, nullptr);
+    if (rc != 0)
+    {
+      ec = std::error_code{rc, std::system_category()};
+      return false;
+    }
+  }
+  return true;
+}
+
+inline void signal_set::clear()
+{
+  for (int signo = 1; signo < NSIG; signo++)
+  {
+    std::error_code ignore{};
+    if (contains(signo)) remove(signo, ignore);
+  }
+}
+
+template <typename SignalHandler>
+void signal_set::async_wait(SignalHandler&& sh)
+{
+  using handler_type = typename std::decay_t<SignalHandler>;
+
+  assert (desc_.get() != -1 && "No signals added to the set");
+
+  // Already delivered signals would not generate
+  // a fresh edge on the signalfd.
+  int signo = 0;
+  std::error_code ec{};
+  if (read_pending(signo, ec) || ec)
+  {
+    ios_.post([ec, signo, handler{handler_type{std::forward<SignalHandler>(sh)}}]() mutable
+              {
+                handler(ec, signo);
+              });
+    return;
+  }
+
+  auto op = new detail::signal_op<handler_type>{
+                 *this, std::forward<SignalHandler>(sh)};
+  start_reactor_op(reactor_ops::read_op, op);
+}
+
+inline bool signal_set::read_pending(int& signo, std::error_code& ec)
+{
+  ec.clear();
+  signo = 0;
+
+  signalfd_siginfo info;
+  while (true)
+  {
+    ssize_t rbytes = ::read(desc_.get(), &info, sizeof(info));
+    if (rbytes == sizeof(info))
+    {
+      signo = static_cast<int>(info.ssi_signo);
+      return true;
+    }
+
+    if (rbytes < 0 && errno == EINTR) continue;
+    if (rbytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return false;
+
+    ec = std::error_code{rbytes < 0 ? errno : EIO, std::system_category()};
+    return false;
+  }
+}
+
+inline bool signal_set::update_signalfd(std::error_code& ec)
+{
+  int fd = ::signalfd(desc_.get(), &signals_, SFD_NONBLOCK | SFD_CLOEXEC);
+  if (fd == -1)
+  {
+    ec = std::error_code{errno, std::system_category()};
+    return false;
+  }
+
+  // Only the first call creates the descriptor
+  if (desc_.get() == -1)
+  {
+    desc_.set(fd);
+    int rc = reactor_.register_descriptor(desc_, &desc_state_);
+    if (rc != 0)
+    {
+      ec = std::error_code{rc, std::system_category()};
+      desc_.close();
+      return false;
+    }
+  }
+  return true;
+}
+
+} // END namespace coro-async
+
+#endif
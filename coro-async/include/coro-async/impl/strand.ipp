@@ -0,0 +1,104 @@
+#ifndef CORO_ASYNC_STRAND_IPP
+#define CORO_ASYNC_STRAND_IPP
+
+#include <tuple>
+#include <cassert>
+#include <type_traits>
+#include "coro-async/detail/scheduler_op.hpp"
+
+namespace coro_async {
+
+template <typename Handler>
+void strand::post(Handler&& h)
+{
+  using handler_type = typename std::decay_t<Handler>;
+
+  auto op = new detail::scheduler_op<handler_type>{handler_type{std::forward<Handler>(h)}};
+  post_op(op);
+}
+
+template <typename Handler>
+auto strand::wrap(Handler&& h)
+{
+  using handler_type = typename std::decay_t<Handler>;
+
+  return [this, handler = handler_type{std::forward<Handler>(h)}](auto&&... args) mutable
+         {
+           this->post([handler = std::move(handler),
+                       args = std::make_tuple(std::forward<decltype(args)>(args)...)]() mutable
+                      {
+                        std::apply(handler, std::move(args));
+                      });
+         };
+}
+
+inline void strand::post_op(detail::operation_base* op)
+{
+  auto head = incoming_.load(std::memory_order_relaxed);
+  do
+  {
+    op->next_ = head;
+  }
+  while (!incoming_.compare_exchange_weak(head, op,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+
+  // The first pending operation schedules the runner
+  if (pending_.fetch_add(1, std::memory_order_acq_rel) == 0)
+  {
+    ios_.post([this] { this->run_ready(); });
+  }
+}
+
+inline void strand::run_ready()
+{
+  const strand* outer = current_;
+  current_ = this;
+
+  for (size_t n = 0; n < max_batch; n++)
+  {
+    if (ready_.is_empty())
+    {
+      // Take everything posted so far and reverse
+      // it back into the post order.
+      auto op = incoming_.exchange(nullptr, std::memory_order_acquire);
+      detail::operation_base* reversed = nullptr;
+      while (op)
+      {
+        auto next = op->next_;
+        op->next_ = reversed;
+        reversed = op;
+        op = next;
+      }
+      while (reversed)
+      {
+        auto next = reversed->next_;
+        reversed->next_ = nullptr;
+        ready_.push(reversed);
+        reversed = next;
+      }
+    }
+
+    // A non zero `pending_` guarantees a pushed operation
+    assert (!ready_.is_empty());
+    auto op = ready_.pop();
+
+    std::error_code ec{};
+    op->call(op, ec, 0);
+
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      current_ = outer;
+      return;
+    }
+  }
+
+  // Let the other handlers of the io_service and the
+  // reactor run. Ownership is kept as `pending_` is non zero.
+  current_ = outer;
+  ios_.defer([this] { this->run_ready(); });
+}
+
+} // END namespace coro_async
+
+#endif
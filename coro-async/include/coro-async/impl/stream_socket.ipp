@@ -6,26 +6,59 @@
 #include "coro-async/detail/write_op.hpp"
 #include "coro-async/detail/socket_ops.hpp"
 #include "coro-async/detail/connect_op.hpp"
+#include "coro-async/detail/fd_passing_op.hpp"
 #include "coro-async/detail/reactor_ops.hpp"
 #include "coro-async/detail/descriptor_op.hpp"
 
 namespace coro_async {
 
-template <typename CompletionHandler>
-void stream_socket::async_connect(endpoint ep, CompletionHandler&& ch)
+inline int stream_socket::release(std::error_code& ec)
+{
+  ec.clear();
+
+  if (!is_open())
+  {
+    ec = std::error_code{EBADF, std::system_category()};
+    return -1;
+  }
+
+  if (impl_.desc_state_)
+  {
+    if (impl_.desc_state_->has_pending_ops())
+    {
+      ec = std::error_code{EBUSY, std::system_category()};
+      return -1;
+    }
+
+    int rc = reactor_.deregister_descriptor(impl_.desc_);
+    if (rc != 0)
+    {
+      ec = std::error_code{rc, std::system_category()};
+      return -1;
+    }
+
+    delete impl_.desc_state_;
+    impl_.desc_state_ = nullptr;
+  }
+
+  return impl_.desc_.release();
+}
+
+template <typename Endpoint, typename CompletionHandler>
+void stream_socket::async_connect(const Endpoint& ep, CompletionHandler&& ch)
 {
   if (!is_open())
   {
     std::error_code ec{};
-    if (!open(ec)) return;
+    if (!open(ep.family(), ec)) return;
     //TODO: Call completion handler with error
   }
   start_connect_op(ep, std::forward<CompletionHandler>(ch));
   return;
 }
 
-template <typename CompletionHandler>
-void stream_socket::start_connect_op(endpoint ep, CompletionHandler&& ch)
+template <typename Endpoint, typename CompletionHandler>
+void stream_socket::start_connect_op(const Endpoint& ep, CompletionHandler&& ch)
 {
   using handler_type = typename std::decay_t<CompletionHandler>;
 
@@ -37,7 +70,7 @@ void stream_socket::start_connect_op(endpoint ep, CompletionHandler&& ch)
     if (ec.value() == static_cast<int>(error::socket_errc::in_progress) ||
         ec.value() == static_cast<int>(error::socket_errc::would_block))
     {
-      auto op = new detail::connect_op<handler_type>{*this, ep, std::forward<CompletionHandler>(ch)};
+      auto op = new detail::connect_op<handler_type>{*this, std::forward<CompletionHandler>(ch)};
       start_reactor_op(reactor_ops::connect_op, op);
       return;
     }
@@ -129,6 +162,36 @@ void stream_socket::async_write(buffer::buffer_ref& buf, WriteHandler&& wh)
   return;
 }
 
+template <typename Buffer, typename WriteHandler>
+void stream_socket::async_send_fds(
+    const Buffer& buf, const int* fds, size_t nfds, WriteHandler&& wh)
+{
+  using handler_type = typename std::decay_t<WriteHandler>;
+
+  assert (is_open() && "Send on an unconnected unix socket");
+
+  auto op = new detail::send_fds_op<handler_type>{
+                 *this, buf, fds, nfds, std::forward<WriteHandler>(wh)};
+  start_reactor_op(reactor_ops::write_op, op);
+
+  return;
+}
+
+template <typename Buffer, typename ReadHandler>
+void stream_socket::async_recv_fds(
+    const Buffer& buf, int* fds, size_t max_fds, ReadHandler&& rh)
+{
+  using handler_type = typename std::decay_t<ReadHandler>;
+
+  assert (is_open() && "Receive on an unconnected unix socket");
+
+  auto op = new detail::recv_fds_op<handler_type>{
+                 *this, buf, fds, max_fds, std::forward<ReadHandler>(rh)};
+  start_reactor_op(reactor_ops::read_op, op);
+
+  return;
+}
+
 } // END namespace coro-async
 
 #endif
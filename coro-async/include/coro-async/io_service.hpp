@@ -24,32 +24,145 @@
 #define CORO_ASYNC_IO_SERVICE_HPP
 
 #include <queue>
+#include <thread>
 #include <vector>
 #include <functional>
 #include "coro-async/detail/scheduler.hpp"
 #include "coro-async/detail/epoll_reactor.hpp"
+#include "coro-async/detail/threading_policy.hpp"
 
 namespace coro_async {
 
+/**
+ * The part of an io_service the I/O objects need: its reactor,
+ * posting and timers. Independent of the threading policy, so
+ * that the sockets and the other I/O objects can be owned by
+ * any `basic_io_service`.
+ *
+ * Calls go through a table of function pointers filled in by
+ * the io_service, the way the operations are completed.
+ * The io_service itself calls its scheduler directly.
+ */
+class io_executor
+{
+public:
+  io_executor(const io_executor&) = delete;
+  io_executor& operator=(const io_executor&) = delete;
+
+public:
+  ///
+  detail::epoll_reactor& get_reactor() noexcept
+  {
+    return fns_->get_reactor_(this);
+  }
+
+  /// Run `task` on the io_service.
+  template <typename TaskFn>
+  void post(TaskFn&& task, priority prio = priority::normal);
+
+  /// Run `task` in the next loop iteration.
+  template <typename TaskFn>
+  void defer(TaskFn&& task);
+
+  /// Post an operation owned by the caller.
+  void post_op(detail::operation_base* op, priority prio = priority::normal)
+  {
+    fns_->post_op_(this, op, prio);
+  }
+
+  /// Run the caller owned operation `op` in the next loop iteration.
+  void defer_op(detail::operation_base* op)
+  {
+    fns_->defer_op_(this, op);
+  }
+
+  ///
+  template <typename T>
+  void schedule_after(std::chrono::seconds secs, T&& cb)
+  {
+    schedule_after(std::chrono::milliseconds(secs), std::forward<T>(cb));
+  }
+
+  ///
+  template <typename T>
+  void schedule_after(std::chrono::milliseconds msecs, T&& cb)
+  {
+    fns_->schedule_after_(this, msecs, detail::unique_function<void()>{std::forward<T>(cb)});
+  }
+
+protected:
+  /// Implemented by the io_service
+  struct functions
+  {
+    detail::epoll_reactor& (*get_reactor_)(io_executor*) noexcept;
+    void (*post_op_)(io_executor*, detail::operation_base*, priority);
+    void (*defer_op_)(io_executor*, detail::operation_base*);
+    void (*schedule_after_)(io_executor*, std::chrono::milliseconds,
+                            detail::unique_function<void()>&&);
+  };
+
+  ///
+  explicit io_executor(const functions& fns) noexcept
+    : fns_(&fns)
+  {
+  }
+
+  ~io_executor() = default;
+
+private:
+  ///
+  const functions* fns_;
+};
+
 /**
  * Talks to the scheduler and schedules tasks.
  * Runs the scheduler.
+ *
+ * `Threading` is the threading policy of the scheduler:
+ * `multi_threaded` (the `io_service`) or `single_threaded`,
+ * which compiles the locks and the atomics out for an
+ * io_service only ever touched by the thread running it.
+ *
+ * NOTE: The sockets and the other I/O objects are bound to
+ * its `io_executor` part and work with either policy.
+ * The components completing work from other threads take an
+ * `io_service` and reject a single threaded one at compile time.
  */
-class io_service
+template <typename Threading>
+class basic_io_service: public io_executor
 {
 public:
+  /// The threading policy
+  using threading_policy = Threading;
+
+  /**
+   */
+  explicit basic_io_service()
+    : io_executor(functions_)
+  {
+  }
+
   /**
+   * \param policy - How posted handlers are distributed
+   *                 among the threads calling `run`.
+   * \param concurrency - The number of threads expected to
+   *                      call `run`.
    */
-  explicit io_service() = default;
+  explicit basic_io_service(scheduling_policy policy,
+                            size_t concurrency = std::thread::hardware_concurrency())
+    : io_executor(functions_)
+    , scheduler_(policy, concurrency)
+  {
+  }
 
   /// Non copyable and non assignable
-  io_service(const io_service&) = delete;
+  basic_io_service(const basic_io_service&) = delete;
 
-  io_service(io_service&&) = delete;
+  basic_io_service(basic_io_service&&) = delete;
 
-  io_service& operator=(const io_service&) = delete;
+  basic_io_service& operator=(const basic_io_service&) = delete;
 
-  io_service& operator=(io_service&&) = delete;
+  basic_io_service& operator=(basic_io_service&&) = delete;
 
 public:
   ///
@@ -72,18 +185,252 @@ public:
     scheduler_.schedule_after(msecs, std::forward<T>(cb));
   }
 
+  /**
+   * Run the event loop till `stop` is called.
+   * Returns the number of handlers executed.
+   */
+  size_t run();
+
+  /// Block till one handler is executed or the loop is stopped.
+  size_t run_one();
+
+  /**
+   * Run the handlers which are ready without blocking.
+   * Meant to be called once per tick of an outer loop.
+   */
+  size_t poll();
+
+  /// Run atmost one ready handler without blocking.
+  size_t poll_one();
+
+  /// Run the event loop for `dur` or till it is stopped.
+  template <typename Rep, typename Period>
+  size_t run_for(const std::chrono::duration<Rep, Period>& dur);
+
+  /// Make `run` return. Thread safe.
+  void stop() noexcept
+  {
+    scheduler_.stop();
+  }
+
   ///
-  void run();
+  bool stopped() const noexcept
+  {
+    return scheduler_.stopped();
+  }
+
+  /// Must be called before running a stopped io_service again.
+  void restart() noexcept
+  {
+    scheduler_.restart();
+  }
+
+  /// Wake up the thread blocked in the reactor. Thread safe.
+  void wake() noexcept
+  {
+    scheduler_.wake();
+  }
+
+  /**
+   * Add work polled on every loop iteration.
+   * To be called before running the io_service.
+   */
+  void add_loop_hook(const detail::loop_hook* hook)
+  {
+    scheduler_.add_loop_hook(hook);
+  }
 
   ///
+  void remove_loop_hook(const detail::loop_hook* hook)
+  {
+    scheduler_.remove_loop_hook(hook);
+  }
+
+  /**
+   * Time spent blocked waiting for work, summed over the
+   * running threads. Thread safe.
+   */
+  std::chrono::nanoseconds idle_time() const noexcept
+  {
+    return scheduler_.idle_time();
+  }
+
+  /**
+   * Spin on the reactor for upto `budget` before blocking,
+   * for the lowest wake up latency at the cost of a busy core.
+   * To be set before running the io_service.
+   */
+  void set_spin_budget(std::chrono::nanoseconds budget) noexcept
+  {
+    scheduler_.set_spin_budget(budget);
+  }
+
+  /**
+   * Let the kernel busy poll the NIC queues of the sockets from
+   * within `epoll_wait` (Linux 6.9+). Pairs with the per socket
+   * `set_busy_poll`.
+   */
+  void set_busy_poll(std::chrono::microseconds usecs, uint16_t budget,
+                     bool prefer, std::error_code& ec)
+  {
+    scheduler_.get_reactor().set_busy_poll(
+        static_cast<uint32_t>(usecs.count()), budget, prefer, ec);
+  }
+
+  /// Loop utilization and spin counters. Thread safe.
+  loop_stats stats() const noexcept
+  {
+    return scheduler_.stats();
+  }
+
+  /**
+   * The epoll descriptor, for nesting the io_service in
+   * another event loop. It only reports descriptor readiness:
+   * posted handlers and timers still need a `poll` every tick.
+   */
+  int native_handle() noexcept
+  {
+    return scheduler_.get_reactor().native_handle();
+  }
+
+  /**
+   * Run `task` on the io_service. High priority tasks run
+   * before the normal ones already queued.
+   */
+  template <typename TaskFn>
+  void post(TaskFn&& task, priority prio = priority::normal);
+
+  /**
+   * Run `task` right away if the calling thread is running
+   * the io_service, else `post` it. Saves the allocation and
+   * the queue hop for completions already on the loop thread.
+   * NOTE: Not to be used where the caller does not expect the
+   * task to run before `dispatch` returns.
+   */
+  template <typename TaskFn>
+  void dispatch(TaskFn&& task, priority prio = priority::normal);
+
+  /**
+   * Run `task` in the next loop iteration, after the reactor
+   * has been polled and the handlers queued so far have run.
+   * Thread safe.
+   */
   template <typename TaskFn>
-  void post(TaskFn&& task);
+  void defer(TaskFn&& task);
+
+  /**
+   * Post an operation owned by the caller, for awaitables
+   * which embed their operation. Does not allocate.
+   */
+  void post_op(detail::operation_base* op, priority prio = priority::normal)
+  {
+    scheduler_.post_op(op, prio);
+  }
+
+  /**
+   * Run the caller owned operation `op` in the next loop
+   * iteration, after the reactor has been polled and the
+   * operations already queued have run. Thread safe.
+   */
+  void defer_op(detail::operation_base* op)
+  {
+    scheduler_.defer_op(op);
+  }
+
+  /**
+   * Max posted handlers run per loop iteration before the
+   * reactor and the timers get their turn again, so that
+   * a handler re-posting itself cannot starve I/O.
+   * To be set before running the io_service.
+   */
+  void set_handler_budget(size_t budget) noexcept
+  {
+    scheduler_.set_handler_budget(budget);
+  }
+
+  /// The io_service the calling thread is running, if any.
+  static basic_io_service* current() noexcept
+  {
+    return current_;
+  }
+
+  /// Is the calling thread running this io_service.
+  bool running_in_this_thread() const noexcept
+  {
+    return current_ == this;
+  }
+
+private:
+  /// Marks the calling thread as running the io_service.
+  class run_scope
+  {
+  public:
+    run_scope(basic_io_service& ios) noexcept;
+    ~run_scope();
+
+    run_scope(const run_scope&) = delete;
+    run_scope& operator=(const run_scope&) = delete;
+
+  private:
+    basic_io_service* prev_;
+  };
+
+  /// The `io_executor` functions
+  static detail::epoll_reactor& do_get_reactor(io_executor* ex) noexcept
+  {
+    return static_cast<basic_io_service*>(ex)->scheduler_.get_reactor();
+  }
+
+  static void do_post_op(io_executor* ex, detail::operation_base* op, priority prio)
+  {
+    static_cast<basic_io_service*>(ex)->scheduler_.post_op(op, prio);
+  }
+
+  static void do_defer_op(io_executor* ex, detail::operation_base* op)
+  {
+    static_cast<basic_io_service*>(ex)->scheduler_.defer_op(op);
+  }
+
+  static void do_schedule_after(io_executor* ex, std::chrono::milliseconds msecs,
+                                detail::unique_function<void()>&& cb)
+  {
+    static_cast<basic_io_service*>(ex)->scheduler_.schedule_after(msecs, std::move(cb));
+  }
+
+  static constexpr io_executor::functions functions_{
+    &basic_io_service::do_get_reactor,
+    &basic_io_service::do_post_op,
+    &basic_io_service::do_defer_op,
+    &basic_io_service::do_schedule_after,
+  };
 
 private:
   /// Scheduler instance
-  detail::scheduler scheduler_;
+  detail::basic_scheduler<Threading> scheduler_;
+
+  /// The io_service being run by the calling thread
+  static inline thread_local basic_io_service* current_;
 };
 
+/// The io_service run and posted to from any number of threads
+using io_service = basic_io_service<multi_threaded>;
+
+namespace detail {
+
+/**
+ * For the components completing work on an io_service from
+ * other threads: a single threaded one fails to compile.
+ */
+template <typename Threading>
+constexpr bool assert_concurrent() noexcept
+{
+  static_assert(Threading::concurrent,
+                "Completes work from other threads: needs a multi_threaded io_service");
+  return true;
+}
+
+} // END namespace detail
+
 } // END namespace coro-async
 
 #include "coro-async/impl/io_service.ipp"
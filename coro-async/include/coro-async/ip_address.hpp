@@ -26,9 +26,12 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <array>
+#include <string>
+#include <cstring>
 #include <string_view>
 #include <exception>
 #include <system_error>
+#include <cassert>
 
 #include "coro-async/error_codes.hpp"
 
@@ -106,11 +109,272 @@ public:
     return addr_;
   }
 
+  /// Dotted decimal representation
+  std::string to_string() const
+  {
+    char buf[INET_ADDRSTRLEN];
+    ::inet_ntop(AF_INET, &addr_, buf, sizeof(buf));
+    return buf;
+  }
+
+  /// Equality comparison on the raw address
+  friend bool operator==(const v4_address& a, const v4_address& b) noexcept
+  {
+    return a.addr_.s_addr == b.addr_.s_addr;
+  }
+
+  friend bool operator!=(const v4_address& a, const v4_address& b) noexcept
+  {
+    return !(a == b);
+  }
+
 private:
   /// The OS address type 
   struct in_addr addr_;
 };
 
+
+/**
+ * The IPv6 address helper class.
+ */
+class v6_address
+{
+public:
+  /// The address type
+  static const IPType address_type = IPType::IPv6;
+
+  /// Raw byte representation of IPv6 address in memory
+  using raw_bytes_t = std::array<unsigned char, 16>;
+
+public:
+  /**
+   * The unspecified address (::).
+   */
+  v6_address() = default;
+
+  /**
+   */
+  v6_address(const raw_bytes_t& bytes, uint32_t scope_id = 0)
+    : scope_id_(scope_id)
+  {
+    ::memcpy(addr_.s6_addr, bytes.data(), 16);
+  }
+
+  /**
+   */
+  v6_address(const struct in6_addr& addr, uint32_t scope_id = 0)
+    : addr_(addr)
+    , scope_id_(scope_id)
+  {
+  }
+
+  /**
+   */
+  v6_address(std::string_view address)
+  {
+    // inet_pton needs a null terminated string
+    std::string str{address};
+    int rc = inet_pton(AF_INET6, str.c_str(), &addr_);
+    if (rc != 1)
+    {
+      auto ec = std::error_code{EINVAL, error::theAddressErrorCat};
+      throw std::system_error{ec, "Invalid IPv6 address"};
+    }
+  }
+
+  /// The unspecified address. Used for listening on all interfaces.
+  static v6_address any() noexcept
+  {
+    return {};
+  }
+
+  /// The loopback address (::1).
+  static v6_address loopback() noexcept
+  {
+    return v6_address{in6addr_loopback};
+  }
+
+  /**
+   */
+  in6_addr native_addr() const noexcept
+  {
+    return addr_;
+  }
+
+  /// The scope id for link local addresses
+  uint32_t scope_id() const noexcept
+  {
+    return scope_id_;
+  }
+
+  /// Is it an IPv4 address mapped into IPv6 (::ffff:a.b.c.d)
+  bool is_v4_mapped() const noexcept
+  {
+    return IN6_IS_ADDR_V4MAPPED(&addr_);
+  }
+
+  /// Textual representation
+  std::string to_string() const
+  {
+    char buf[INET6_ADDRSTRLEN];
+    ::inet_ntop(AF_INET6, &addr_, buf, sizeof(buf));
+    return buf;
+  }
+
+  /// Equality comparison on the raw address
+  friend bool operator==(const v6_address& a, const v6_address& b) noexcept
+  {
+    return ::memcmp(&a.addr_, &b.addr_, sizeof(in6_addr)) == 0 &&
+           a.scope_id_ == b.scope_id_;
+  }
+
+  friend bool operator!=(const v6_address& a, const v6_address& b) noexcept
+  {
+    return !(a == b);
+  }
+
+private:
+  /// The OS address type
+  struct in6_addr addr_ = IN6ADDR_ANY_INIT;
+  /// Interface scope for link local addresses
+  uint32_t scope_id_ = 0;
+};
+
+
+/**
+ * Either an IPv4 or an IPv6 address.
+ */
+class ip_address
+{
+public:
+  /**
+   * The unspecified IPv4 address.
+   */
+  ip_address() noexcept
+  {
+    addr_.v4_.s_addr = INADDR_ANY;
+  }
+
+  ///
+  ip_address(const v4_address& addr) noexcept
+    : type_(IPType::IPv4)
+  {
+    addr_.v4_ = addr.native_addr();
+  }
+
+  ///
+  ip_address(const v6_address& addr) noexcept
+    : type_(IPType::IPv6)
+    , scope_id_(addr.scope_id())
+  {
+    addr_.v6_ = addr.native_addr();
+  }
+
+  /**
+   * Parses either an IPv4 or an IPv6 address.
+   * Throws `std::system_error` if it is neither.
+   */
+  ip_address(std::string_view address)
+  {
+    if (!from_string(address, *this))
+    {
+      auto ec = std::error_code{EINVAL, error::theAddressErrorCat};
+      throw std::system_error{ec, "Invalid IP address"};
+    }
+  }
+
+  /**
+   * Non throwing parse.
+   * Returns false if `str` is neither IPv4 nor IPv6 address.
+   */
+  static bool from_string(std::string_view str, ip_address& addr) noexcept
+  {
+    char buf[INET6_ADDRSTRLEN];
+    if (str.size() >= sizeof(buf)) return false;
+    ::memcpy(buf, str.data(), str.size());
+    buf[str.size()] = '\0';
+
+    in_addr v4;
+    if (inet_pton(AF_INET, buf, &v4) == 1)
+    {
+      addr = v4_address{v4};
+      return true;
+    }
+
+    in6_addr v6;
+    if (inet_pton(AF_INET6, buf, &v6) == 1)
+    {
+      addr = v6_address{v6};
+      return true;
+    }
+    return false;
+  }
+
+public:
+  ///
+  IPType type() const noexcept
+  {
+    return type_;
+  }
+
+  ///
+  bool is_v4() const noexcept
+  {
+    return type_ == IPType::IPv4;
+  }
+
+  ///
+  bool is_v6() const noexcept
+  {
+    return type_ == IPType::IPv6;
+  }
+
+  ///
+  v4_address to_v4() const noexcept
+  {
+    assert (is_v4());
+    return v4_address{addr_.v4_};
+  }
+
+  ///
+  v6_address to_v6() const noexcept
+  {
+    assert (is_v6());
+    return v6_address{addr_.v6_, scope_id_};
+  }
+
+  ///
+  std::string to_string() const
+  {
+    return is_v4() ? to_v4().to_string() : to_v6().to_string();
+  }
+
+  ///
+  friend bool operator==(const ip_address& a, const ip_address& b) noexcept
+  {
+    if (a.type_ != b.type_) return false;
+    return a.is_v4() ? a.to_v4() == b.to_v4()
+                     : a.to_v6() == b.to_v6();
+  }
+
+  friend bool operator!=(const ip_address& a, const ip_address& b) noexcept
+  {
+    return !(a == b);
+  }
+
+private:
+  /// The address family
+  IPType type_ = IPType::IPv4;
+  /// Scope id for IPv6 link local addresses
+  uint32_t scope_id_ = 0;
+  /// The OS address
+  union
+  {
+    in_addr v4_;
+    in6_addr v6_;
+  } addr_;
+};
+
 } // END namespace coro-async
 
 
@@ -0,0 +1,107 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_LOCAL_ACCEPTOR_HPP
+#define CORO_ASYNC_LOCAL_ACCEPTOR_HPP
+
+#include "coro-async/io_service.hpp"
+#include "coro-async/stream_socket.hpp"
+#include "coro-async/local_endpoint.hpp"
+
+namespace coro_async {
+
+/**
+ * Acceptor for unix domain stream sockets.
+ * The accepted sockets are plain `stream_socket`s and
+ * support the usual read / write operations along with
+ * descriptor passing.
+ */
+class local_acceptor
+{
+public:
+  /**
+   */
+  local_acceptor(io_executor& ios)
+    : ios_(ios)
+    , socket_(ios)
+  {
+  }
+
+  local_acceptor(const local_acceptor&) = delete;
+  local_acceptor& operator=(const local_acceptor&) = delete;
+
+  ~local_acceptor() = default;
+
+public:
+  ///
+  io_executor& get_io_service()
+  {
+    return ios_;
+  }
+
+  ///
+  bool is_open() const noexcept
+  {
+    return socket_.is_open();
+  }
+
+  ///
+  bool open(std::error_code& ec) noexcept
+  {
+    ec.clear();
+    return socket_.open(AF_UNIX, ec);
+  }
+
+  /**
+   * Bind to the socket path of `ep`.
+   * Fails with EADDRINUSE if the path already exists.
+   */
+  void bind(const local_endpoint& ep, std::error_code& ec)
+  {
+    socket_.bind(ep, ec);
+    return;
+  }
+
+  ///
+  void listen(unsigned backlog, std::error_code& ec)
+  {
+    socket_.listen(backlog, ec);
+    return;
+  }
+
+public: // Async APIs
+  /**
+   */
+  template <typename CompletionHandler>
+  void async_accept(stream_socket& sock, CompletionHandler&& ch);
+
+private:
+  ///
+  io_executor& ios_;
+  ///
+  stream_socket socket_;
+};
+
+} // END namespace coro_async
+
+#include "coro-async/impl/local_acceptor.ipp"
+
+#endif
@@ -0,0 +1,143 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_LOCAL_ENDPOINT_HPP
+#define CORO_ASYNC_LOCAL_ENDPOINT_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <sys/un.h>
+#include <sys/socket.h>
+
+namespace coro_async {
+
+/**
+ * Represents a unix domain socket endpoint.
+ * A path starting with '\0' names a socket in the
+ * linux abstract namespace which has no file system entry.
+ */
+class local_endpoint
+{
+public:
+  /// The unnamed endpoint.
+  local_endpoint() noexcept
+  {
+    ::memset(&addr_, 0, sizeof(addr_));
+    addr_.sun_family = AF_UNIX;
+    size_ = offsetof(sockaddr_un, sun_path);
+  }
+
+  /**
+   * Endpoint for the socket at `path`.
+   * Throws std::system_error (ENAMETOOLONG) if the
+   * path does not fit in `sockaddr_un`.
+   */
+  explicit local_endpoint(std::string_view path)
+    : local_endpoint()
+  {
+    // Leave space for the terminating null of a file system path
+    const size_t max_len = sizeof(addr_.sun_path) - (is_abstract(path) ? 0 : 1);
+    if (path.size() > max_len)
+    {
+      throw std::system_error{std::error_code{ENAMETOOLONG, std::system_category()},
+                              "local_endpoint"};
+    }
+
+    ::memcpy(addr_.sun_path, path.data(), path.size());
+    size_ = offsetof(sockaddr_un, sun_path) + path.size() + (is_abstract(path) ? 0 : 1);
+  }
+
+  /// Endpoint from a native socket address
+  local_endpoint(const sockaddr* addr, socklen_t len) noexcept
+    : local_endpoint()
+  {
+    if (len > sizeof(addr_)) len = sizeof(addr_);
+    ::memcpy(&addr_, addr, len);
+    size_ = len;
+  }
+
+public:
+  /// Always AF_UNIX
+  int family() const noexcept
+  {
+    return AF_UNIX;
+  }
+
+  /// The socket path. Empty for an unnamed endpoint.
+  std::string path() const
+  {
+    const size_t len = size_ - offsetof(sockaddr_un, sun_path);
+    if (len == 0) return {};
+    if (addr_.sun_path[0] == '\0') return { addr_.sun_path, len };
+    return { addr_.sun_path, ::strnlen(addr_.sun_path, len) };
+  }
+
+  /// Is it an abstract namespace endpoint
+  bool is_abstract() const noexcept
+  {
+    return size_ > offsetof(sockaddr_un, sun_path) && addr_.sun_path[0] == '\0';
+  }
+
+  /// The native socket address
+  const sockaddr* data() const noexcept
+  {
+    return reinterpret_cast<const sockaddr*>(&addr_);
+  }
+
+  /// Size of the native socket address
+  socklen_t size() const noexcept
+  {
+    return size_;
+  }
+
+  ///
+  friend bool operator==(const local_endpoint& a, const local_endpoint& b) noexcept
+  {
+    return a.size_ == b.size_ && ::memcmp(&a.addr_, &b.addr_, a.size_) == 0;
+  }
+
+  ///
+  friend bool operator!=(const local_endpoint& a, const local_endpoint& b) noexcept
+  {
+    return !(a == b);
+  }
+
+private:
+  ///
+  static bool is_abstract(std::string_view path) noexcept
+  {
+    return !path.empty() && path[0] == '\0';
+  }
+
+private:
+  /// The native address
+  sockaddr_un addr_;
+  /// Length of the used part of `addr_`
+  socklen_t size_ = 0;
+};
+
+} // END namespace coro_async
+
+#endif
@@ -0,0 +1,179 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_POSIX_STREAM_DESCRIPTOR_HPP
+#define CORO_ASYNC_POSIX_STREAM_DESCRIPTOR_HPP
+
+#include "coro-async/io_service.hpp"
+#include "coro-async/buffer_ref.hpp"
+#include "coro-async/detail/descriptor.hpp"
+#include "coro-async/detail/operation_base.hpp"
+#include "coro-async/detail/retire_descriptor.hpp"
+
+namespace coro_async {
+
+/**
+ * An async handle over any pollable stream like file
+ * descriptor: pipes, eventfd, ttys, inotify etc.
+ * Uses the same read / write operations as `stream_socket`.
+ *
+ * NOTE: Regular files cannot be used as epoll does not
+ * support them (`assign` fails with EPERM).
+ */
+class posix_stream_descriptor
+{
+private:
+  ///
+  struct implementation
+  {
+    detail::descriptor desc_;
+    //Allocated when called register_descriptor
+    detail::descriptor_state* desc_state_ = nullptr;
+  };
+
+public:
+  /**
+   */
+  posix_stream_descriptor(io_executor& io_srv)
+    : reactor_(io_srv.get_reactor())
+    , ios_(io_srv)
+  {
+  }
+
+  /// Move copy constructible
+  posix_stream_descriptor(posix_stream_descriptor&& other)
+    : reactor_(other.reactor_)
+    , ios_(other.ios_)
+  {
+    impl_.desc_ = std::move(other.impl_.desc_);
+    impl_.desc_state_ = other.impl_.desc_state_;
+    other.impl_.desc_state_ = nullptr;
+  }
+
+  posix_stream_descriptor(const posix_stream_descriptor&) = delete;
+
+  posix_stream_descriptor& operator=(const posix_stream_descriptor&) = delete;
+
+  ~posix_stream_descriptor()
+  {
+    close();
+  }
+
+public:
+  /// Check if a descriptor is assigned
+  bool is_open() const noexcept
+  {
+    return impl_.desc_.get() != -1;
+  }
+
+  /**
+   * Take ownership of `fd`, make it non-blocking and
+   * register it with the reactor.
+   */
+  bool assign(int fd, std::error_code& ec)
+  {
+    ec.clear();
+
+    assert (!is_open());
+
+    impl_.desc_.set(fd);
+
+    int rc = reactor_.register_descriptor(impl_.desc_, &impl_.desc_state_);
+    if (rc != 0)
+    {
+      ec = std::error_code{rc, std::system_category()};
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Close the descriptor. The pending operations
+   * complete with ECANCELED.
+   */
+  void close()
+  {
+    detail::retire_descriptor(ios_, reactor_, impl_.desc_, impl_.desc_state_);
+    impl_.desc_.close();
+  }
+
+  /// Get the native descriptor
+  typename detail::descriptor::descriptor_type
+  get_native_handle() const noexcept
+  {
+    return impl_.desc_.get();
+  }
+
+  ///
+  io_executor& get_io_service() noexcept
+  {
+    return ios_;
+  }
+
+  /**
+   */
+  void start_reactor_op(enum reactor_ops r_op, detail::operation_base* op)
+  {
+    reactor_.start_op(impl_.desc_, impl_.desc_state_, r_op, op);
+  }
+
+public: // Async Operations
+  /**
+   * Reads atmost buf.size() data into the Buffer.
+   * Buffer must exist till async_read_some finishes execution.
+   */
+  template <typename Buffer, typename ReadHandler>
+  void async_read_some(const Buffer& buf, ReadHandler&& rh);
+
+  /**
+   * Makes sure that it reads atleast `buf.size()` data.
+   */
+  template <typename ReadHandler>
+  void async_read(buffer::buffer_ref& buf, ReadHandler&& rh);
+
+  /**
+   * Writes atmost buf.size() data to the descriptor.
+   * Buffer must exist till async_write_some finishes execution.
+   */
+  template <typename Buffer, typename WriteHandler>
+  void async_write_some(const Buffer& buf, WriteHandler&& wh);
+
+  /**
+   * Makes sure that it writes atleast all the data in the
+   * buffer.
+   */
+  template <typename WriteHandler>
+  void async_write(buffer::buffer_ref& buf, WriteHandler&& wh);
+
+private:
+  ///
+  implementation impl_;
+  ///
+  detail::epoll_reactor& reactor_;
+  ///
+  io_executor& ios_;
+};
+
+} // END namespace coro-async
+
+#include "coro-async/impl/posix_stream_descriptor.ipp"
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef CORO_ASYNC_RESOLVER_HPP
+#define CORO_ASYNC_RESOLVER_HPP
+
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include <condition_variable>
+#include <sys/socket.h>
+
+#include "coro-async/endpoint.hpp"
+#include "coro-async/io_service.hpp"
+#include "coro-async/ip_address.hpp"
+#include "coro-async/error_codes.hpp"
+
+namespace coro_async {
+
+/**
+ * Asynchronous host name resolver with an in-memory cache.
+ *
+ * Lookup order:
+ * 1. Numeric address literals.
+ * 2. The hosts file (read once at construction).
+ * 3. The cache. An expired entry is still served for
+ *    `stale_ttl` while it is refreshed in the background.
+ * 4. `getaddrinfo` on a few helper threads, so that one slow
+ *    name does not hold up the others. Concurrent lookups for
+ *    the same name share a single query.
+ *
+ * The handlers are always invoked on the io_service thread.
+ * Since `getaddrinfo` does not expose the record TTLs, cached
+ * answers live for `ttl` and failures for `negative_ttl`.
+ *
+ * NOTE: `async_resolve` must only be called from the thread
+ * running the io_service.
+ */
+class resolver
+{
+public:
+  /// The clock used for cache expiry
+  using clock_type = std::chrono::steady_clock;
+
+  /// The resolved endpoints
+  using results_type = std::vector<endpoint>;
+
+  /// Configuration of the resolver cache
+  struct options
+  {
+    /// How long a successful answer is fresh
+    std::chrono::milliseconds ttl = std::chrono::seconds(30);
+    /// How long an expired answer may still be served
+    std::chrono::milliseconds stale_ttl = std::chrono::seconds(300);
+    /// How long a failed lookup is remembered
+    std::chrono::milliseconds negative_ttl = std::chrono::seconds(5);
+    /// The hosts file. Empty to skip.
+    std::string hosts_file = "/etc/hosts";
+    /// AF_INET, AF_INET6 or AF_UNSPEC for both
+    int family = AF_UNSPEC;
+    /// Number of helper threads running `getaddrinfo`
+    size_t lookup_threads = 4;
+  };
+
+public:
+  ///
+  resolver(io_service& ios)
+    : resolver(ios, options{})
+  {
+  }
+
+  ///
+  resolver(io_service& ios, options opts);
+
+  /// The queries complete on the lookup threads.
+  template <typename Threading, typename... Opts, bool = detail::assert_concurrent<Threading>()>
+  resolver(basic_io_service<Threading>&, Opts&&...) = delete;
+
+  resolver(const resolver&) = delete;
+  resolver& operator=(const resolver&) = delete;
+
+  /**
+   * Does not wait for the queries in flight: their helper
+   * threads drop the answers. The lookups still waiting
+   * on a query complete with ECANCELED.
+   */
+  ~resolver();
+
+public:
+  /**
+   * Resolve `host` to a list of endpoints with `port`.
+   * Handler signature: void(const std::error_code&, results_type)
+   */
+  template <typename ResolveHandler>
+  void async_resolve(std::string host, uint16_t port, ResolveHandler&& rh);
+
+  /**
+   * Answer from the literal / hosts / cache without blocking.
+   * Returns false if a query is required.
+   * An expired entry being served also triggers its refresh.
+   */
+  bool try_resolve(const std::string& host, uint16_t port,
+                   results_type& res, std::error_code& ec);
+
+  ///
+  io_service& get_io_service() noexcept
+  {
+    return ios_;
+  }
+
+private:
+  /// The resolved addresses, independent of the port
+  using addresses_type = std::vector<ip_address>;
+
+  /// A lookup waiting for the query to finish
+  struct waiter
+  {
+    uint16_t port_;
+    std::function<void(const std::error_code&, results_type)> handler_;
+  };
+
+  /// A cached answer
+  struct cache_entry
+  {
+    addresses_type addrs_;
+    std::error_code ec_;
+    clock_type::time_point expires_;
+    /// Whether a query for this name is in flight
+    bool querying_ = false;
+  };
+
+  /// `try_resolve` for an already lower cased host name.
+  bool try_resolve_normalized(const std::string& host, uint16_t port,
+                              results_type& res, std::error_code& ec);
+
+  ///
+  static results_type to_endpoints(const addresses_type& addrs, uint16_t port);
+
+  /// Load the hosts file.
+  void load_hosts(const std::string& path);
+
+  /// Does `addr` match the configured family.
+  bool family_allowed(const ip_address& addr) const noexcept;
+
+  /**
+   * The query queue. Shared with the helper threads, which
+   * may outlive the resolver while blocked in `getaddrinfo`.
+   */
+  struct query_queue
+  {
+    /// Lock to protect the queue
+    std::mutex lock_;
+    /// Query available event
+    std::condition_variable event_;
+    /// Names to be queried
+    std::deque<std::string> names_;
+    /// Null once the resolver is gone
+    resolver* owner_ = nullptr;
+  };
+
+  /// Queue a query to the helper threads.
+  void start_query(const std::string& host);
+
+  /// Hand the answer over to the io_service thread. Called
+  /// by a helper thread with the queue lock held.
+  void post_answer(std::string host, addresses_type addrs, std::error_code ec);
+
+  /// Called on the io_service thread once the query is done.
+  void on_query_done(const std::string& host, addresses_type addrs, std::error_code ec);
+
+  /// The helper thread loop.
+  static void query_loop(std::shared_ptr<query_queue> queue, int family);
+
+  /// Blocking lookup.
+  static addresses_type do_query(const std::string& host, int family, std::error_code& ec);
+
+private:
+  /// The io_service instance
+  io_service& ios_;
+
+  /// Configuration
+  options opts_;
+
+  /// Entries from the hosts file
+  std::unordered_map<std::string, addresses_type> hosts_;
+
+  /// Cached answers (io_service thread only)
+  std::unordered_map<std::string, cache_entry> cache_;
+
+  /// Lookups waiting on a query (io_service thread only)
+  std::unordered_map<std::string, std::vector<waiter>> waiters_;
+
+  /// Guards the completions posted from the helper thread
+  std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
+
+  /// The queries for the helper threads
+  std::shared_ptr<query_queue> queries_ = std::make_shared<query_queue>();
+};
+
+} // END namespace coro_async
+
+#include "coro-async/impl/resolver.ipp"
+
+#endif
@@ -0,0 +1,169 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_SHARD_GROUP_HPP
+#define CORO_ASYNC_SHARD_GROUP_HPP
+
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+#include "coro-async/io_service.hpp"
+#include "coro-async/cpu_topology.hpp"
+
+namespace coro_async {
+
+/**
+ * A set of shards, each an `io_service` run by its own thread
+ * pinned to a CPU.
+ *
+ * Every io_service is constructed on its pinned thread, so with
+ * the kernel's first touch policy its queues, reactor and timer
+ * state come from the NUMA node of its CPU, as does whatever the
+ * loop allocates later on (operations, coroutine frames, buffers).
+ * `on_start` runs there as well, before the loop, to set up the
+ * per shard pools; `node_id` gives the node for memory which is
+ * not touched first by the shard (see `cpu_topology::bind_memory`).
+ *
+ * On a single node host the placement is plain CPU pinning. A
+ * failed pin is not fatal: the shard still runs, unpinned, and
+ * the error is kept in `pin_error`.
+ */
+class shard_group
+{
+public:
+  /// Per shard set up, called on the shard thread before it runs.
+  using start_fn = std::function<void(size_t shard, io_service& ios)>;
+
+  /// Placement of the shards
+  struct options
+  {
+    /// CPU of every shard. Empty to use `cpu_topology::pick_cpus`.
+    std::vector<int> cpus;
+    /// Set false to only record the placement, eg. in tests
+    bool pin = true;
+  };
+
+public:
+  /**
+   * Constructor.
+   * \param n - Number of shards.
+   * \param topo - The topology to place the shards on.
+   */
+  shard_group(size_t n, const cpu_topology& topo = cpu_topology::system())
+    : shard_group(n, topo, options{})
+  {
+  }
+
+  ///
+  shard_group(size_t n, const cpu_topology& topo, options opts);
+
+  shard_group(const shard_group&) = delete;
+  shard_group& operator=(const shard_group&) = delete;
+
+  /// Stops and joins the shards.
+  ~shard_group();
+
+public:
+  /**
+   * Start the shard threads. Returns once every io_service
+   * is constructed and its `on_start` has returned.
+   */
+  void start(start_fn on_start = {});
+
+  /// Stop all the shards. Thread safe.
+  void stop() noexcept;
+
+  /// Wait for the shard threads to exit.
+  void join();
+
+  /// Number of shards
+  size_t size() const noexcept
+  {
+    return slots_.size();
+  }
+
+  /// The io_service of `shard`. Only valid after `start`.
+  io_service& shard(size_t shard) noexcept
+  {
+    return *slots_[shard]->ios_;
+  }
+
+  /// All the io_services, eg. for a `shard_mesh`. After `start`.
+  std::vector<io_service*> shards() const;
+
+  /// The CPU `shard` is placed on
+  int cpu(size_t shard) const noexcept
+  {
+    return slots_[shard]->cpu_;
+  }
+
+  /// The sysfs id of the NUMA node of `shard`, or -1 if unknown.
+  int node_id(size_t shard) const noexcept
+  {
+    return slots_[shard]->node_id_;
+  }
+
+  /// Why `shard` could not be pinned, if it could not.
+  const std::error_code& pin_error(size_t shard) const noexcept
+  {
+    return slots_[shard]->pin_ec_;
+  }
+
+private:
+  /// A shard
+  struct slot
+  {
+    int cpu_ = -1;
+    int node_id_ = -1;
+    std::error_code pin_ec_;
+    std::unique_ptr<io_service> ios_;
+    std::thread thread_;
+  };
+
+  /// The shard thread.
+  void run_shard(size_t id, const start_fn& on_start);
+
+private:
+  /// Placement
+  options opts_;
+
+  /// The shards
+  std::vector<std::unique_ptr<slot>> slots_;
+
+  /// Guards `started_`
+  std::mutex lock_;
+
+  /// Signalled as the shards get ready
+  std::condition_variable ready_event_;
+
+  /// Shards constructed and set up
+  size_t started_ = 0;
+};
+
+} // END namespace coro_async
+
+#include "coro-async/impl/shard_group.ipp"
+
+#endif
@@ -0,0 +1,155 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_SHARD_MESH_HPP
+#define CORO_ASYNC_SHARD_MESH_HPP
+
+#include <memory>
+#include <vector>
+
+#include "coro-async/io_service.hpp"
+#include "coro-async/detail/spsc_ring.hpp"
+#include "coro-async/detail/operation_base.hpp"
+#include "coro-async/detail/operation_queue.hpp"
+
+namespace coro_async {
+
+/**
+ * Shared nothing message passing between shards, where a
+ * shard is an `io_service` run by a single thread.
+ *
+ * Every ordered pair of shards gets a bounded single producer
+ * single consumer ring. A message is an operation which runs on
+ * the receiving shard. Sending never blocks: if the ring is full
+ * the message waits in a queue local to the sender and is moved
+ * over as the receiver catches up.
+ *
+ * Every shard polls the mesh once per loop iteration. It drains
+ * the rings addressed to it and wakes the receivers of what it
+ * sent since the last poll, with atmost one wake up per receiver
+ * per batch (and none if the receiver is not sleeping).
+ *
+ * NOTE: `send` / `submit_to` with a given `from` must only be
+ * called on the thread running shard `from`. The mesh must be
+ * created before the shards start running and destroyed after
+ * they stop.
+ */
+class shard_mesh
+{
+public:
+  /**
+   * Constructor.
+   * \param shards - The io_services, indexed by shard id.
+   * \param ring_capacity - Messages in flight per pair before
+   *                        the sender side queue is used.
+   */
+  explicit shard_mesh(std::vector<io_service*> shards, size_t ring_capacity = 1024);
+
+  /// The shards wake each other from their own threads.
+  template <typename Threading, bool = detail::assert_concurrent<Threading>()>
+  explicit shard_mesh(std::vector<basic_io_service<Threading>*>, size_t = 1024) = delete;
+
+  shard_mesh(const shard_mesh&) = delete;
+  shard_mesh& operator=(const shard_mesh&) = delete;
+
+  /// Unhooks the mesh from the shards.
+  ~shard_mesh();
+
+public:
+  /// Number of shards
+  size_t size() const noexcept
+  {
+    return shards_.size();
+  }
+
+  ///
+  io_service& shard(size_t id) noexcept
+  {
+    return *shards_[id];
+  }
+
+  /**
+   * Run `fn` on shard `to`. Called on shard `from`.
+   * The message is allocated; see `send` for caller owned ones.
+   */
+  template <typename Fn>
+  void submit_to(size_t from, size_t to, Fn&& fn);
+
+  /**
+   * Run the caller owned operation `op` on shard `to`.
+   * Called on shard `from`. `op` is called with an empty
+   * error code.
+   */
+  void send(size_t from, size_t to, detail::operation_base* op);
+
+private:
+  /// The channel for one ordered pair of shards
+  struct mailbox
+  {
+    explicit mailbox(size_t capacity)
+      : ring_(capacity)
+    {
+    }
+
+    /// The messages in flight
+    detail::spsc_ring<detail::operation_base*> ring_;
+    /// Messages which did not fit in the ring (sender only)
+    operation_queue<detail::operation_base> overflow_;
+    /// Sent since the last wake up (sender only)
+    bool unnotified_ = false;
+  };
+
+  /// The per shard hook context
+  struct shard_hook
+  {
+    shard_mesh* mesh_ = nullptr;
+    size_t id_ = 0;
+    detail::loop_hook hook_;
+  };
+
+  ///
+  mailbox& box(size_t from, size_t to) noexcept
+  {
+    return *boxes_[from * shards_.size() + to];
+  }
+
+  /// Drain the incoming rings and flush the outgoing ones.
+  size_t poll(size_t id);
+
+  /// Is there anything to drain or flush for shard `id`.
+  bool pending(size_t id);
+
+private:
+  /// The shards
+  std::vector<io_service*> shards_;
+
+  /// The mailboxes, `from * size() + to`
+  std::vector<std::unique_ptr<mailbox>> boxes_;
+
+  /// The hooks registered with the shards
+  std::vector<std::unique_ptr<shard_hook>> hooks_;
+};
+
+} // END namespace coro_async
+
+#include "coro-async/impl/shard_mesh.ipp"
+
+#endif
@@ -0,0 +1,134 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_SIGNAL_SET_HPP
+#define CORO_ASYNC_SIGNAL_SET_HPP
+
+#include <signal.h>
+#include <system_error>
+
+#include "coro-async/io_service.hpp"
+#include "coro-async/detail/descriptor.hpp"
+#include "coro-async/detail/operation_base.hpp"
+
+namespace coro_async {
+
+/**
+ * Delivers signals on the io_service thread.
+ *
+ * The signals added to the set are blocked and read from
+ * a `signalfd` registered with the reactor, so the handlers
+ * run as ordinary completions and need not be signal safe.
+ * A signal raised while nobody is waiting stays pending in
+ * the kernel until the next `async_wait`.
+ *
+ * NOTE: The signal mask is per thread. Add the signals
+ * before starting any other thread, so that the threads
+ * inherit the blocked mask. Else a thread which does not
+ * block the signal gets it delivered the default way.
+ */
+class signal_set
+{
+public:
+  ///
+  signal_set(io_executor& io_srv)
+    : reactor_(io_srv.get_reactor())
+    , ios_(io_srv)
+  {
+    sigemptyset(&signals_);
+    sigemptyset(&blocked_by_us_);
+  }
+
+  signal_set(const signal_set&) = delete;
+  signal_set& operator=(const signal_set&) = delete;
+
+  /**
+   * Closes the signalfd and unblocks the signals.
+   * The pending waits complete with ECANCELED.
+   */
+  ~signal_set();
+
+public:
+  /// Block `signo` and start reading it from the signalfd.
+  bool add(int signo, std::error_code& ec);
+
+  /// Stop reading `signo` and restore its blocked state.
+  bool remove(int signo, std::error_code& ec);
+
+  /// Remove all the signals.
+  void clear();
+
+  /// Is `signo` part of the set.
+  bool contains(int signo) const noexcept
+  {
+    return sigismember(&signals_, signo) == 1;
+  }
+
+  /**
+   * Wait for one of the signals in the set.
+   * Handler signature: void(const std::error_code&, int signo)
+   */
+  template <typename SignalHandler>
+  void async_wait(SignalHandler&& sh);
+
+  /**
+   * Dequeue a delivered signal without waiting.
+   * Returns false (with no error) if none is pending.
+   */
+  bool read_pending(int& signo, std::error_code& ec);
+
+  ///
+  io_executor& get_io_service() noexcept
+  {
+    return ios_;
+  }
+
+  /**
+   */
+  void start_reactor_op(enum reactor_ops r_op, detail::operation_base* op)
+  {
+    reactor_.start_op(desc_, desc_state_, r_op, op);
+  }
+
+private:
+  /// Create or update the signalfd with the current set.
+  bool update_signalfd(std::error_code& ec);
+
+private:
+  /// The signalfd
+  detail::descriptor desc_;
+  /// Allocated when the signalfd is registered
+  detail::descriptor_state* desc_state_ = nullptr;
+  /// The signals in the set
+  sigset_t signals_;
+  /// The signals which were unblocked before being added
+  sigset_t blocked_by_us_;
+  ///
+  detail::epoll_reactor& reactor_;
+  ///
+  io_executor& ios_;
+};
+
+} // END namespace coro-async
+
+#include "coro-async/impl/signal_set.ipp"
+
+#endif
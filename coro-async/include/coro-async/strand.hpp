@@ -0,0 +1,120 @@
+/*
+  Copyright (c) 2018 Arun Muralidharan
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CORO_ASYNC_STRAND_HPP
+#define CORO_ASYNC_STRAND_HPP
+
+#include <atomic>
+#include <utility>
+
+#include "coro-async/io_service.hpp"
+#include "coro-async/detail/operation_base.hpp"
+#include "coro-async/detail/operation_queue.hpp"
+
+namespace coro_async {
+
+/**
+ * Serializes the handlers posted through it.
+ *
+ * No two handlers of a strand run concurrently, even when the
+ * io_service is run by many threads, and they run in the order
+ * they were posted. The strand does not take any lock: posting
+ * pushes onto a lock free stack, and the thread which takes the
+ * pending count from zero schedules a single runner on the
+ * io_service which drains the strand.
+ *
+ * The completions of asynchronous operations are serialized by
+ * passing the handler through `wrap`.
+ *
+ * NOTE: The strand must outlive all the handlers posted to it.
+ */
+class strand
+{
+public:
+  ///
+  explicit strand(io_executor& ios)
+    : ios_(ios)
+  {
+  }
+
+  strand(const strand&) = delete;
+  strand& operator=(const strand&) = delete;
+
+public:
+  /// Run `h` on the strand.
+  template <typename Handler>
+  void post(Handler&& h);
+
+  /**
+   * Returns a handler which, when invoked by an operation,
+   * runs `h` with the same arguments on the strand.
+   */
+  template <typename Handler>
+  auto wrap(Handler&& h);
+
+  /**
+   * Post an operation owned by the caller, for awaitables
+   * which embed their operation. `op` is called with an
+   * empty error code.
+   */
+  void post_op(detail::operation_base* op);
+
+  /// Is the calling thread running a handler of this strand.
+  bool running_in_this_thread() const noexcept
+  {
+    return current_ == this;
+  }
+
+  ///
+  io_executor& get_io_service() noexcept
+  {
+    return ios_;
+  }
+
+private:
+  /// Drain the strand. Exactly one runner exists at a time.
+  void run_ready();
+
+private:
+  /// Handlers run by a runner before it yields the thread
+  static constexpr size_t max_batch = 64;
+
+  /// The io_service running the strand
+  io_executor& ios_;
+
+  /// Posted operations, most recent first
+  std::atomic<detail::operation_base*> incoming_{nullptr};
+
+  /// Posted operations not yet run
+  std::atomic<size_t> pending_{0};
+
+  /// Operations taken off `incoming_` in post order (runner only)
+  operation_queue<detail::operation_base> ready_;
+
+  /// The strand whose handler the calling thread runs
+  static inline thread_local const strand* current_ = nullptr;
+};
+
+} // END namespace coro_async
+
+#include "coro-async/impl/strand.ipp"
+
+#endif
@@ -29,6 +29,7 @@
 #include "coro-async/io_service.hpp"
 #include "coro-async/ip_address.hpp"
 #include "coro-async/buffer_ref.hpp"
+#include "coro-async/local_endpoint.hpp"
 #include "coro-async/detail/descriptor.hpp"
 #include "coro-async/detail/socket_ops.hpp"
 #include "coro-async/detail/operation_base.hpp"
@@ -54,7 +55,7 @@ private:
 public:
   /**
    */
-  stream_socket(io_service& io_srv)
+  stream_socket(io_executor& io_srv)
     : reactor_(io_srv.get_reactor())
     , ios_(io_srv)
   {
@@ -90,12 +91,21 @@ public:
     return impl_.desc_.get() != -1;
   }
 
-  /// Opens up the socket and registers with reactor
+  /// Opens up an IPv4 socket and registers with reactor
   bool open(std::error_code& ec)
+  {
+    return open(AF_INET, ec);
+  }
+
+  /**
+   * Opens up the socket for the address `family`
+   * (AF_INET, AF_INET6 or AF_UNIX) and registers with reactor.
+   */
+  bool open(int family, std::error_code& ec)
   {
     ec.clear();
 
-    int sd = socket(AF_INET, SOCK_STREAM, 0);
+    int sd = socket(family, SOCK_STREAM, 0);
     if (sd == -1)
     {
       ec = std::error_code{errno, std::system_category()};
@@ -141,6 +151,16 @@ public:
     return true;
   }
 
+  /**
+   * Detach the socket from its io_service and give up the
+   * ownership of the descriptor, eg. to `assign` it to a
+   * socket of another io_service. Nothing queued in the kernel
+   * is lost.
+   * Fails with EBUSY if any operation is pending on the socket.
+   * Returns the descriptor, or -1 on failure.
+   */
+  int release(std::error_code& ec);
+
   /// Get the native socket descriptor
   typename detail::descriptor::descriptor_type
   get_native_handle() const noexcept
@@ -148,14 +168,18 @@ public:
     return impl_.desc_.get();
   }
 
-  /// Binds the socket with (ip:port)
-  void bind(endpoint ep, std::error_code& ec)
+  /**
+   * Binds the socket with (ip:port) or to a unix socket path.
+   * `Endpoint` is either `endpoint` or `local_endpoint`.
+   */
+  template <typename Endpoint>
+  void bind(const Endpoint& ep, std::error_code& ec)
   {
     ec.clear();
 
     if (!is_open())
     {
-      if (!open(ec)) return;
+      if (!open(ep.family(), ec)) return;
     }
     detail::posix_socket_ops::bind(get_native_handle(), ep, ec);
     return;
@@ -175,6 +199,24 @@ public:
     return;
   }
 
+  /**
+   * With `priority::high` the completions of the socket are run
+   * ahead of those of normal sockets ready in the same reactor
+   * batch. Must be set after the socket is opened or assigned.
+   */
+  void set_priority(priority prio) noexcept
+  {
+    assert (impl_.desc_state_);
+    impl_.desc_state_->high_priority_ = (prio == priority::high);
+  }
+
+  /// Busy poll the socket's device queue. See `posix_socket_ops::set_busy_poll`.
+  void set_busy_poll(std::chrono::microseconds usecs, bool prefer, std::error_code& ec)
+  {
+    detail::posix_socket_ops::set_busy_poll(
+        get_native_handle(), static_cast<int>(usecs.count()), prefer, ec);
+  }
+
   /**
    */
   void start_reactor_op(enum reactor_ops r_op, detail::operation_base* op)
@@ -184,14 +226,16 @@ public:
 
   /**
    */
-  template <typename CompletionHandler>
-  void start_connect_op(endpoint ep, CompletionHandler&& ch);
+  template <typename Endpoint, typename CompletionHandler>
+  void start_connect_op(const Endpoint& ep, CompletionHandler&& ch);
 
 public: // Async Operations
   /**
+   * Connects to `ep` which is either an `endpoint`
+   * or a `local_endpoint`.
    */
-  template <typename CompletionHandler>
-  void async_connect(endpoint ep, CompletionHandler&& ch);
+  template <typename Endpoint, typename CompletionHandler>
+  void async_connect(const Endpoint& ep, CompletionHandler&& ch);
 
   /**
    * Reads atmost buf.size() data into the Buffer.
@@ -225,13 +269,34 @@ public: // Async Operations
   template <typename WriteHandler>
   void async_write(buffer::buffer_ref& buf, WriteHandler&& wh);
 
+  /**
+   * Sends the data in `buf` along with `nfds` descriptors
+   * over a unix domain socket. The descriptors are duplicated
+   * into the peer process and stay open here.
+   * `buf` must not be empty and must exist till the operation
+   * finishes. `fds` is copied.
+   * Handler signature: void(const std::error_code&, size_t bytes_wrote)
+   */
+  template <typename Buffer, typename WriteHandler>
+  void async_send_fds(const Buffer& buf, const int* fds, size_t nfds, WriteHandler&& wh);
+
+  /**
+   * Reads atmost buf.size() data from a unix domain socket
+   * along with upto `max_fds` passed descriptors into `fds`.
+   * Both `buf` and `fds` must exist till the operation finishes.
+   * Handler signature:
+   *   void(const std::error_code&, size_t bytes_read, size_t nfds)
+   */
+  template <typename Buffer, typename ReadHandler>
+  void async_recv_fds(const Buffer& buf, int* fds, size_t max_fds, ReadHandler&& rh);
+
 private:
   ///
   implementation impl_;
   ///
   detail::epoll_reactor& reactor_;
   ///
-  io_service& ios_;
+  io_executor& ios_;
 };
 
 
@@ -37,7 +37,7 @@ class tcp_acceptor
 public:
   /**
    */
-  tcp_acceptor(io_service& ios)
+  tcp_acceptor(io_executor& ios)
     : ios_(ios)
     , socket_(ios)
   {
@@ -50,7 +50,7 @@ public:
 
 public:
   ///
-  io_service& get_io_service()
+  io_executor& get_io_service()
   {
     return ios_;
   }
@@ -68,6 +68,50 @@ public:
     return socket_.open(ec);
   }
 
+  /// Open for the address `family` (AF_INET or AF_INET6)
+  bool open(int family, std::error_code& ec) noexcept
+  {
+    ec.clear();
+    return socket_.open(family, ec);
+  }
+
+  /**
+   * Restrict an IPv6 acceptor to IPv6 only.
+   * With `false`, IPv4 clients are accepted as well and
+   * show up as v4 mapped IPv6 addresses.
+   * Must be called before `bind`.
+   */
+  void set_v6_only(bool v6_only, std::error_code& ec)
+  {
+    detail::posix_socket_ops::set_option(
+        socket_.get_native_handle(), IPPROTO_IPV6, IPV6_V6ONLY, v6_only ? 1 : 0, ec);
+  }
+
+  /**
+   * Let several acceptors (eg. one per shard) bind the same
+   * address, the kernel spreading the connections among them.
+   * Must be called before `bind`.
+   */
+  void set_reuse_port(bool reuse, std::error_code& ec)
+  {
+    detail::posix_socket_ops::set_option(
+        socket_.get_native_handle(), SOL_SOCKET, SO_REUSEPORT, reuse ? 1 : 0, ec);
+  }
+
+  /**
+   * Steer every connection of the SO_REUSEPORT group this
+   * acceptor belongs to by the CPU which received it: it goes
+   * to the `cpu % group_size`th acceptor bound to the address.
+   * With the acceptor of shard `i` bound `i`th and shard `i`
+   * running on CPU `i`, connections are handled on the core that
+   * got their packets. Call once the whole group is bound.
+   */
+  void steer_by_incoming_cpu(unsigned group_size, std::error_code& ec)
+  {
+    detail::posix_socket_ops::attach_cpu_steering(
+        socket_.get_native_handle(), group_size, ec);
+  }
+
   ///
   void bind(endpoint ep, std::error_code& ec)
   {
@@ -88,9 +132,26 @@ public: // Async APIs
   template <typename CompletionHandler>
   void async_accept(stream_socket& sock, CompletionHandler&& ch);
 
+  /**
+   * Start an accept operation owned by the caller. `op` is
+   * called once the acceptor is readable and does the accept
+   * itself, eg. to hand the descriptor to another io_service
+   * without registering it here first.
+   */
+  void start_accept_op(detail::operation_base* op)
+  {
+    socket_.start_reactor_op(reactor_ops::read_op, op);
+  }
+
+  /// The listening descriptor
+  int get_native_handle() const noexcept
+  {
+    return socket_.get_native_handle();
+  }
+
 private:
   /// 
-  io_service& ios_;
+  io_executor& ios_;
   ///
   stream_socket socket_;
 };
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+static const size_t num_shards = 3;
+static const uint16_t port = 18093;
+
+// Blocking client connect
+int connect_client()
+{
+  int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (::connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0)
+  {
+    std::cerr << "connect failed" << std::endl;
+  }
+  return fd;
+}
+
+int main() {
+  io_service accept_ios{};
+  std::vector<std::unique_ptr<io_service>> services;
+  std::vector<io_service*> shards;
+  for (size_t i = 0; i < num_shards; i++)
+  {
+    services.emplace_back(new io_service{});
+    shards.push_back(services.back().get());
+  }
+
+  tcp_acceptor acceptor{accept_ios};
+  std::error_code ec{};
+  acceptor.open(ec);
+  acceptor.set_reuse_port(true, ec);
+  acceptor.bind(endpoint{v4_address{"127.0.0.1"}, port}, ec);
+  if (ec)
+  {
+    std::cerr << "bind failed: " << ec.message() << std::endl;
+    return 1;
+  }
+  acceptor.listen(128, ec);
+
+  accept_distributor dist{{ &acceptor }, shards};
+
+  // Each shard only touches its own slot
+  std::vector<std::vector<int>> conns(num_shards);
+  std::atomic<size_t> handled{0};
+
+  dist.start([&](size_t shard, int fd) {
+        conns[shard].push_back(fd);
+        handled.fetch_add(1);
+      });
+
+  std::vector<std::thread> threads;
+  threads.emplace_back([&] { accept_ios.run(); });
+  for (auto s : shards)
+  {
+    threads.emplace_back([s] { s->run(); });
+  }
+
+  auto wait_for = [&](size_t n) {
+    while (handled.load() < n) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  };
+
+  std::vector<int> clients;
+  for (int i = 0; i < 30; i++) clients.push_back(connect_client());
+  wait_for(30);
+
+  std::cout << "after 30 connections:";
+  for (size_t i = 0; i < num_shards; i++) std::cout << ' ' << dist.active_connections(i);
+  std::cout << std::endl;
+
+  // Shard 1 drops all its connections, so it gets all the new ones
+  std::atomic<bool> closed{false};
+  shards[1]->post([&] {
+        for (int fd : conns[1])
+        {
+          ::close(fd);
+          dist.connection_closed(1);
+        }
+        conns[1].clear();
+        closed = true;
+      });
+  while (!closed) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  for (int i = 0; i < 10; i++) clients.push_back(connect_client());
+  wait_for(40);
+
+  std::cout << "after shard 1 closed and 10 more:";
+  for (size_t i = 0; i < num_shards; i++) std::cout << ' ' << dist.active_connections(i);
+  std::cout << std::endl;
+
+  accept_ios.stop();
+  for (auto s : shards) s->stop();
+  for (auto& t : threads) t.join();
+
+  for (auto& v : conns) for (int fd : v) ::close(fd);
+  for (int fd : clients) ::close(fd);
+  return 0;
+}
@@ -0,0 +1,79 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+static const int round_trips = 2000;
+
+// Echoes every byte straight back
+coro_task_auto<void> echo(coro_socket sock)
+{
+  const int fd = sock.get_stream_sock().get_native_handle();
+  for (int i = 0; i < round_trips; i++)
+  {
+    char c[1];
+    auto bref = as_buffer(c);
+    auto res = co_await sock.read(1, bref);
+    if (res.is_error()) co_return;
+    ::write(fd, c, 1);
+  }
+  co_return;
+}
+
+// Average round trip against a loop spinning for `budget`
+double measure(std::chrono::nanoseconds budget)
+{
+  io_service ios{};
+  ios.set_spin_budget(budget);
+
+  int sv[2];
+  ::socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+
+  coro_socket sock{ios};
+  std::error_code ec{};
+  sock.get_stream_sock().assign(sv[0], ec);
+  echo(std::move(sock));
+
+  std::thread thr{[&] { ios.run(); }};
+  auto before = ios.stats();
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < round_trips; i++)
+  {
+    char c = 'x';
+    ::write(sv[1], &c, 1);
+    ::read(sv[1], &c, 1);
+  }
+  const auto took = std::chrono::steady_clock::now() - start;
+
+  auto st = ios.stats().since(before);
+  std::cout << "spin " << budget.count() / 1000 << "us:"
+            << " spin hits " << (st.spin_hits > 0)
+            << ", sleeps " << (st.sleeps > 0)
+            << ", utilization in [0, 1] " << (st.utilization() >= 0.0 && st.utilization() <= 1.0)
+            << std::endl;
+
+  ios.stop();
+  thr.join();
+  ::close(sv[1]);
+
+  return std::chrono::duration<double, std::micro>(took).count() / round_trips;
+}
+
+int main() {
+  // Not supported by every kernel, just report it
+  io_service probe{};
+  std::error_code ec{};
+  probe.set_busy_poll(std::chrono::microseconds(50), 8, true, ec);
+  std::cout << "epoll busy poll: " << (ec ? ec.message() : "enabled") << std::endl;
+
+  double slept = measure(std::chrono::nanoseconds(0));
+  double spun = measure(std::chrono::microseconds(200));
+  std::cerr << "avg round trip: " << slept << "us sleeping, "
+            << spun << "us spinning" << std::endl;
+  return 0;
+}
@@ -0,0 +1,123 @@
+#include <iostream>
+#include <thread>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+static const uint16_t port = 18094;
+static const int num_requests = 5;
+
+// SO_REUSEPORT lets the next run bind while the
+// connections of this one are still in TIME_WAIT.
+void listen_on(coro_acceptor& acc, uint16_t port, std::error_code& ec)
+{
+  auto& a = acc.get_underlying_acceptor();
+  if (a.open(AF_INET, ec)) a.set_reuse_port(true, ec);
+  if (!ec) a.bind(endpoint{v4_address{"127.0.0.1"}, port}, ec);
+  if (!ec) a.listen(128, ec);
+}
+
+coro_task_auto<void> handle_client(coro_socket client)
+{
+  // Serves requests till the pool closes the connection
+  while (true)
+  {
+    char buf[6]; // for only "Hello!"
+    auto bref = as_buffer(buf);
+    auto rd = co_await client.read(6, bref);
+    if (rd.is_error() || rd.result() == 0) break;
+    bref = as_buffer(buf);
+    co_await client.write(6, bref);
+  }
+  client.close();
+  co_return;
+}
+
+coro_task_auto<void> server_run(coro_acceptor& acc)
+{
+  while ( true )
+  {
+    auto result = co_await acc.accept();
+    if (result.is_error()) co_return;
+    handle_client(std::move(result.result()));
+  }
+  co_return;
+}
+
+// Failed requests count too, else the loop never stops
+void finished(io_service& ios, int& done)
+{
+  if (++done == num_requests)
+  {
+    ios.stop();
+  }
+}
+
+coro_task_auto<void> request(io_service& ios, connection_pool& pool, endpoint ep, int id, int& done)
+{
+  auto result = co_await pool.connect(ep);
+  if (result.is_error())
+  {
+    std::cerr << "Connect failed: " << result.error().message() << '\n';
+    finished(ios, done);
+    co_return;
+  }
+
+  auto& sock = result.result();
+  char buf[6] = {'H', 'e', 'l', 'l', 'o', '!'};
+  auto bref = as_buffer(buf);
+  co_await sock.write(6, bref);
+  bref = as_buffer(buf);
+  auto rd = co_await sock.read(6, bref);
+
+  if (rd.is_error())
+  {
+    pool.discard(ep);
+  }
+  else
+  {
+    std::cout << "request " << id << " done. live: "
+              << pool.live_connections(ep) << std::endl;
+    pool.release(ep, std::move(sock));
+  }
+
+  finished(ios, done);
+  co_return;
+}
+
+coro_task_auto<void> bad_address(connection_pool& pool)
+{
+  auto result = co_await pool.connect("not-an-ip", port);
+  std::cout << "invalid address rejected: " << result.is_error() << std::endl;
+  co_return;
+}
+
+int main() {
+  io_service ios{};
+  coro_acceptor acceptor{ios};
+
+  std::error_code ec{};
+  listen_on(acceptor, port, ec);
+  if (ec)
+  {
+    std::cout << "error: " << ec.message() << std::endl;
+    return -1;
+  }
+  server_run(acceptor);
+
+  // At most 2 connections, idle ones closed after 1 second
+  connection_pool pool{ios, 2, std::chrono::seconds(1)};
+  endpoint ep{v4_address{"127.0.0.1"}, port};
+
+  bad_address(pool);
+
+  int done = 0;
+  for (int i = 0; i < num_requests; i++)
+  {
+    request(ios, pool, ep, i, done);
+  }
+
+  std::thread thr{[&] { ios.run(); }};
+  thr.join();
+  return 0;
+}
@@ -0,0 +1,74 @@
+#include <iostream>
+#include <atomic>
+#include <string>
+#include <fstream>
+#include <sched.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+// A fake two socket sysfs tree, with a memory only node
+std::string make_fake_topology()
+{
+  char tmpl[] = "/tmp/fake_topoXXXXXX";
+  std::string root = ::mkdtemp(tmpl);
+
+  const char* lists[] = { "0-3,8-11", "4-7,12-15", "" };
+  for (int i = 0; i < 3; i++)
+  {
+    auto dir = root + "/node" + std::to_string(i);
+    ::mkdir(dir.c_str(), 0755);
+    std::ofstream{dir + "/cpulist"} << lists[i] << '\n';
+  }
+  return root;
+}
+
+int main() {
+  auto root = make_fake_topology();
+  cpu_topology fake{root};
+
+  std::cout << "fake: nodes " << fake.num_nodes()
+            << ", cpus " << fake.num_cpus()
+            << ", numa " << fake.is_numa()
+            << ", cpu 9 on node " << fake.node_of(9)
+            << ", cpu 13 on node " << fake.node_of(13) << std::endl;
+
+  std::cout << "fake placement of 10:";
+  for (int cpu : fake.pick_cpus(10)) std::cout << ' ' << cpu;
+  std::cout << std::endl;
+
+  // Record the placement on the fake topology without pinning
+  shard_group::options opts;
+  opts.pin = false;
+  opts.cpus = { 2, 6 };
+  {
+    shard_group g{2, fake, opts};
+    std::cout << "fake shards on nodes " << g.node_id(0) << ' ' << g.node_id(1) << std::endl;
+  }
+
+  std::string cleanup = "rm -rf " + root;
+  ::system(cleanup.c_str());
+
+  // The real host, maybe single node
+  const auto& topo = cpu_topology::system();
+  std::cout << "host: nodes " << topo.num_nodes() << ", cpus " << topo.num_cpus() << std::endl;
+
+  shard_group group{2};
+  std::atomic<int> on_cpu{0};
+  group.start([&](size_t shard, io_service& ios) {
+        if (::sched_getcpu() == group.cpu(shard)) on_cpu++;
+      });
+
+  for (size_t i = 0; i < group.size(); i++)
+  {
+    if (group.pin_error(i)) std::cout << "pin failed: " << group.pin_error(i).message() << std::endl;
+  }
+  std::cout << "shards started on their cpu: " << on_cpu << " of " << group.size() << std::endl;
+
+  group.stop();
+  group.join();
+  return 0;
+}
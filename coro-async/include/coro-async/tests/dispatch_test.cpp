@@ -0,0 +1,63 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+std::string order;
+
+coro_task_auto<int> child(coro_scheduler& sched)
+{
+  co_await sched.yield();
+  co_return 7;
+}
+
+coro_task_auto<void> parent(coro_scheduler& sched, io_service& ios)
+{
+  // A yield point: the handler posted before runs first
+  ios.post([] { order += 'p'; });
+  auto r = co_await sched.wait_for([] { return 42; });
+  order += 'w';
+
+  // Resumed by a post once the child has completed
+  auto c = co_await sched.wait_for([&] { return child(sched); });
+  std::cout << "results " << r.result() << ' ' << c.result() << std::endl;
+  co_return;
+}
+
+int main() {
+  io_service ios{};
+  coro_scheduler sched{ios};
+
+  bool inline_ran = false;
+  bool ran_before_return = false;
+  std::thread::id ran_on;
+
+  ios.post([&] {
+        // On the loop thread: runs before `dispatch` returns
+        ios.dispatch([&] { inline_ran = true; });
+        ran_before_return = inline_ran;
+
+        // Deferred work runs after what is posted meanwhile
+        ios.defer([] { order += 'd'; });
+        ios.post([] { order += 'q'; });
+
+        parent(sched, ios);
+      });
+
+  std::thread other{[&] {
+        // Not on the loop thread: posted
+        ios.dispatch([&] { ran_on = std::this_thread::get_id(); });
+      }};
+  other.join();
+
+  ios.schedule_after(std::chrono::milliseconds(50), [&] { ios.stop(); });
+  const auto loop_thread = std::this_thread::get_id();
+  ios.run();
+
+  std::cout << "inline on the loop: " << ran_before_return
+            << ", posted from elsewhere: " << (ran_on == loop_thread)
+            << ", order: " << order << std::endl;
+  return 0;
+}
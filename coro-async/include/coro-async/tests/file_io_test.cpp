@@ -0,0 +1,63 @@
+#include <iostream>
+#include <thread>
+#include <cstring>
+#include <fcntl.h>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+coro_task_auto<void> file_roundtrip(io_service& ios, thread_pool& pool)
+{
+  coro_file file{ios, pool};
+
+  auto res = co_await file.open("/tmp/coro_async_file_test.txt", O_RDWR | O_CREAT | O_TRUNC);
+  if (res.is_error())
+  {
+    std::cerr << "open failed: " << res.error().message() << '\n';
+    ios.stop();
+    co_return;
+  }
+
+  char line[] = "written from the blocking pool\n";
+  auto wres = co_await file.pwrite(buffer::buffer_ref{line, std::strlen(line)}, 0);
+  if (wres.is_error())
+  {
+    std::cerr << "pwrite failed: " << wres.error().message() << '\n';
+    ios.stop();
+    co_return;
+  }
+  std::cout << "wrote " << wres.result() << " bytes" << std::endl;
+
+  auto sres = co_await file.fdatasync();
+  if (sres.is_error())
+  {
+    std::cerr << "fdatasync failed: " << sres.error().message() << '\n';
+    ios.stop();
+    co_return;
+  }
+
+  char buf[64] = {0,};
+  auto rres = co_await file.pread(buffer::buffer_ref{buf, sizeof(buf) - 1}, 0);
+  if (rres.is_error())
+  {
+    std::cerr << "pread failed: " << rres.error().message() << '\n';
+    ios.stop();
+    co_return;
+  }
+  std::cout << "read " << rres.result() << " bytes: " << buf << std::flush;
+
+  file.close();
+  ios.stop();
+  co_return;
+}
+
+int main() {
+  io_service ios{};
+  thread_pool pool{2};
+
+  file_roundtrip(ios, pool);
+
+  std::thread thr{[&] { ios.run(); }};
+  thr.join();
+  return 0;
+}
@@ -0,0 +1,75 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+// Starts serving on `a` and moves itself over to `b`
+coro_task_auto<void> serve(coro_socket sock, io_service& a, io_service& b,
+                           std::thread::id b_id)
+{
+  char first[4];
+  auto bref = as_buffer(first);
+  auto res = co_await sock.read(4, bref);
+  if (res.is_error())
+  {
+    std::cerr << "read failed: " << res.error().message() << '\n';
+    co_return;
+  }
+
+  auto moved = co_await handoff(sock, b);
+  if (moved.is_error())
+  {
+    std::cerr << "handoff failed: " << moved.error().message() << '\n';
+    co_return;
+  }
+  auto& hot = moved.result();
+
+  // Sent before the handoff, still queued in the kernel
+  char second[4];
+  bref = as_buffer(second);
+  res = co_await hot.read(4, bref);
+  if (res.is_error())
+  {
+    std::cerr << "read failed: " << res.error().message() << '\n';
+    co_return;
+  }
+
+  std::cout << "read '" << std::string(first, 4) << "' then '"
+            << std::string(second, 4) << "', on the new loop: "
+            << (std::this_thread::get_id() == b_id) << std::endl;
+
+  a.stop();
+  b.stop();
+  co_return;
+}
+
+int main() {
+  io_service a{};
+  io_service b{};
+
+  int sv[2];
+  if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0)
+  {
+    std::cerr << "socketpair failed" << std::endl;
+    return 1;
+  }
+  ::write(sv[1], "abcdefgh", 8);
+
+  std::thread tb{[&] { b.run(); }};
+
+  coro_socket sock{a};
+  std::error_code ec{};
+  sock.get_stream_sock().assign(sv[0], ec);
+  serve(std::move(sock), a, b, tb.get_id());
+
+  std::thread ta{[&] { a.run(); }};
+
+  ta.join();
+  tb.join();
+  ::close(sv[1]);
+  return 0;
+}
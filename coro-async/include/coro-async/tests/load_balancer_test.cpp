@@ -0,0 +1,130 @@
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+static const uint16_t ports[] = { 18095, 18096 };
+
+// SO_REUSEPORT lets the next run bind while the
+// connections of this one are still in TIME_WAIT.
+void listen_on(coro_acceptor& acc, uint16_t port, std::error_code& ec)
+{
+  auto& a = acc.get_underlying_acceptor();
+  if (a.open(AF_INET, ec)) a.set_reuse_port(true, ec);
+  if (!ec) a.bind(endpoint{v4_address{"127.0.0.1"}, port}, ec);
+  if (!ec) a.listen(128, ec);
+}
+
+coro_task_auto<void> handle_client(coro_socket client)
+{
+  char buf[6]; // for only "Hello!"
+  auto bref = as_buffer(buf);
+  co_await client.read(6, bref);
+  co_await client.write(6, bref);
+  client.close();
+  co_return;
+}
+
+coro_task_auto<void> server_run(coro_acceptor& acc)
+{
+  while ( true )
+  {
+    auto result = co_await acc.accept();
+    if (result.is_error()) co_return;
+    handle_client(std::move(result.result()));
+  }
+  co_return;
+}
+
+coro_task_auto<void> send_requests(io_service& ios, load_balancer& lb, int count)
+{
+  for (int i = 0; i < count; i++)
+  {
+    auto result = co_await lb.connect();
+    if (result.is_error())
+    {
+      std::cerr << "Connect failed: " << result.error().message() << '\n';
+      continue;
+    }
+
+    auto& conn = result.result();
+    char buf[6] = {'H', 'e', 'l', 'l', 'o', '!'};
+    auto bref = as_buffer(buf);
+    co_await conn.sock_.write(6, bref);
+    bref = as_buffer(buf);
+    auto rd = co_await conn.sock_.read(6, bref);
+
+    lb.complete(conn.token_, !rd.is_error());
+
+    const auto idx = conn.token_.backend_;
+    std::cout << "request " << i << " -> backend " << idx
+              << " latency(ns): " << lb.latency(idx).count() << std::endl;
+  }
+
+  // Never awaited: must not hold up a slot
+  { auto unused = lb.connect(); }
+  std::cout << "in flight: " << lb.in_flight(0) << ' ' << lb.in_flight(1) << std::endl;
+
+  ios.stop();
+  co_return;
+}
+
+// The EWMA after a known sequence of samples
+bool check_ewma(io_service& ios)
+{
+  using namespace std::chrono;
+  const auto decay = milliseconds(100);
+  load_balancer lb{ios, { endpoint{v4_address{"127.0.0.1"}, ports[0]} }, decay};
+
+  // A 50ms request: a spike is taken as is
+  auto t = lb.pick();
+  std::this_thread::sleep_for(milliseconds(50));
+  lb.complete(t);
+  const double spike = lb.latency(0).count();
+  const auto after_spike = steady_clock::now();
+
+  // A fast request 70ms later: the spike has decayed by
+  // exp(-dt / decay) and the sample adds rtt * (1 - that).
+  std::this_thread::sleep_for(milliseconds(70));
+  t = lb.pick();
+  lb.complete(t);
+  const double dt = duration<double, std::nano>(steady_clock::now() - after_spike).count();
+  const double w = std::exp(-dt / duration<double, std::nano>(decay).count());
+  const double expected = spike * w;
+
+  const double got = lb.latency(0).count();
+  return std::abs(got - expected) < 0.1 * expected;
+}
+
+int main() {
+  io_service ios{};
+
+  std::cout << "ewma after a known sequence matches: " << check_ewma(ios) << std::endl;
+
+  // The backends
+  coro_acceptor acc0{ios};
+  coro_acceptor acc1{ios};
+  std::error_code ec{};
+  listen_on(acc0, ports[0], ec);
+  if (!ec) listen_on(acc1, ports[1], ec);
+  if (ec)
+  {
+    std::cout << "error: " << ec.message() << std::endl;
+    return -1;
+  }
+  server_run(acc0);
+  server_run(acc1);
+
+  load_balancer lb{ios, {
+      endpoint{v4_address{"127.0.0.1"}, ports[0]},
+      endpoint{v4_address{"127.0.0.1"}, ports[1]},
+    }};
+
+  send_requests(ios, lb, 10);
+
+  std::thread thr{[&] { ios.run(); }};
+  thr.join();
+  return 0;
+}
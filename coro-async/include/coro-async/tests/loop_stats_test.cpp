@@ -0,0 +1,69 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+static const int periods = 20;
+static const auto period = std::chrono::milliseconds(10);
+static const auto busy = std::chrono::milliseconds(8);
+
+// Busy for 8ms inside every read completion
+coro_task_auto<void> reader(coro_socket sock, io_service& ios)
+{
+  // Skip the start up, the window is taken after the first read
+  loop_stats before{};
+  for (int i = 0; i < periods; i++)
+  {
+    char c[1];
+    auto bref = as_buffer(c);
+    auto res = co_await sock.read(1, bref);
+    if (res.is_error()) break;
+    if (i == 0) before = ios.stats();
+
+    const auto until = std::chrono::steady_clock::now() + busy;
+    while (std::chrono::steady_clock::now() < until);
+  }
+
+  auto st = ios.stats().since(before);
+  std::cout << "blocked in the reactor: " << (st.sleeps > 0)
+            << ", utilization of a loop busy in read completions is high: "
+            << (st.utilization() > 0.6) << std::endl;
+  ios.stop();
+  co_return;
+}
+
+int main() {
+  io_service ios{};
+
+  int sv[2];
+  if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0)
+  {
+    std::cout << "socketpair failed" << std::endl;
+    return -1;
+  }
+
+  coro_socket sock{ios};
+  std::error_code ec{};
+  sock.get_stream_sock().assign(sv[0], ec);
+  reader(std::move(sock), ios);
+
+  // One byte per period: the loop blocks, wakes up and is
+  // then busy in the completion for most of the period.
+  std::thread writer{[&] {
+    for (int i = 0; i < periods; i++)
+    {
+      std::this_thread::sleep_for(period);
+      char c = 'x';
+      ::write(sv[1], &c, 1);
+    }
+  }};
+
+  ios.run();
+  writer.join();
+  ::close(sv[1]);
+  return 0;
+}
@@ -0,0 +1,66 @@
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <string>
+#include <stdexcept>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+static int ticks = 0;
+
+coro_task_auto<void> ticker(coro_scheduler& sched)
+{
+  for (int i = 0; i < 10; i++)
+  {
+    co_await sched.yield_for(std::chrono::milliseconds(10));
+    ticks++;
+  }
+  co_return;
+}
+
+coro_task_auto<void> worker(coro_scheduler& sched, thread_pool& pool, io_service& ios)
+{
+  const auto loop_thread = std::this_thread::get_id();
+
+  // Blocks for 100ms, but not the io_service
+  auto res = co_await sched.offload(pool, [] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return std::string{"compressed"};
+      });
+  std::cout << "got '" << res.result() << "' with " << ticks
+            << " ticks meanwhile, back on loop thread: "
+            << (std::this_thread::get_id() == loop_thread) << std::endl;
+
+  co_await sched.offload(pool, [] { std::this_thread::yield(); });
+  std::cout << "void offload done" << std::endl;
+
+  try
+  {
+    co_await sched.offload(pool, []() -> int { throw std::runtime_error{"bad input"}; });
+  }
+  catch (const std::exception& e)
+  {
+    std::cout << "rethrown: " << e.what() << std::flush;
+  }
+
+  // Let the ticker finish
+  while (ticks < 10) co_await sched.yield_for(std::chrono::milliseconds(10));
+  ios.stop();
+  co_return;
+}
+
+int main() {
+  io_service ios{};
+  thread_pool pool{2};
+  coro_scheduler sched{ios};
+
+  ticker(sched);
+
+  std::thread thr{[&] {
+    worker(sched, pool, ios);
+    ios.run();
+  }};
+  thr.join();
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+std::string order;
+
+coro_task_auto<void> reader(coro_socket& sock, char tag)
+{
+  char buf[1];
+  auto bref = as_buffer(buf);
+  auto res = co_await sock.read(1, bref);
+  if (!res.is_error()) order += tag;
+  co_return;
+}
+
+int main() {
+  io_service ios{};
+
+  // High priority posts overtake the normal ones queued before
+  for (int i = 0; i < 5; i++) ios.post([] { order += 'n'; });
+  for (int i = 0; i < 3; i++) ios.post([] { order += 'H'; }, priority::high);
+  while (ios.poll()) {}
+  std::cout << "posts: " << order << std::endl;
+
+  // A long run of high priority work lets normal work through
+  order.clear();
+  for (int i = 0; i < 2; i++) ios.post([] { order += 'n'; });
+  for (int i = 0; i < 20; i++) ios.post([] { order += 'H'; }, priority::high);
+  while (ios.poll()) {}
+  std::cout << "starvation: " << order << std::endl;
+
+  // Ready in the same reactor batch, the high priority socket first
+  order.clear();
+  int normal_sv[2], high_sv[2];
+  ::socketpair(AF_UNIX, SOCK_STREAM, 0, normal_sv);
+  ::socketpair(AF_UNIX, SOCK_STREAM, 0, high_sv);
+
+  std::error_code ec{};
+  coro_socket normal_sock{ios};
+  normal_sock.get_stream_sock().assign(normal_sv[0], ec);
+  coro_socket high_sock{ios};
+  high_sock.get_stream_sock().assign(high_sv[0], ec);
+  high_sock.get_stream_sock().set_priority(priority::high);
+
+  auto t1 = reader(normal_sock, 'n');
+  auto t2 = reader(high_sock, 'H');
+
+  ::write(normal_sv[1], "x", 1);
+  ::write(high_sv[1], "x", 1);
+  while (ios.poll()) {}
+  std::cout << "sockets: " << order << std::endl;
+
+  ::close(normal_sv[1]);
+  ::close(high_sv[1]);
+  return 0;
+}
@@ -0,0 +1,56 @@
+#include <iostream>
+#include <thread>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+static const int num_lookups = 4;
+
+coro_task_auto<void> lookup(coro_resolver& r, const char* host, int& done)
+{
+  // The second lookup is served from memory
+  for (int i = 0; i < 2; i++)
+  {
+    auto result = co_await r.resolve(host, 80);
+    if (result.is_error())
+    {
+      std::cout << host << ": " << result.error().message() << std::endl;
+      continue;
+    }
+    for (auto& ep : result.result())
+    {
+      std::cout << host << ": " << ep.address().to_string()
+                << " port " << ep.port() << std::endl;
+    }
+  }
+
+  if (++done < num_lookups) co_return;
+
+  // A lookup still waiting when its resolver goes away
+  auto& ios = r.get_io_service();
+  {
+    resolver gone{ios};
+    gone.async_resolve("pending.invalid", 80,
+          [&ios](const std::error_code& ec, resolver::results_type)
+          {
+            std::cout << "pending lookup aborted: " << (ec.value() == ECANCELED) << std::endl;
+            ios.stop();
+          });
+  }
+  co_return;
+}
+
+int main() {
+  io_service ios{};
+  coro_resolver r{ios};
+
+  int done = 0;
+  lookup(r, "localhost", done);
+  lookup(r, "127.0.0.1", done);
+  lookup(r, "::1", done);
+  lookup(r, "no-such-host.invalid", done);
+
+  std::thread thr{[&] { ios.run(); }};
+  thr.join();
+  return 0;
+}
@@ -0,0 +1,35 @@
+#include <iostream>
+#include <chrono>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+int main() {
+  io_service ios{};
+  int count = 0;
+
+  for (int i = 0; i < 3; i++) ios.post([&count] { count++; });
+
+  std::cout << "poll_one ran " << ios.poll_one() << std::endl;
+  std::cout << "poll ran " << ios.poll() << std::endl;
+  std::cout << "poll on idle loop ran " << ios.poll() << std::endl;
+
+  ios.schedule_after(std::chrono::milliseconds(20), [&count] { count++; });
+  auto start = std::chrono::steady_clock::now();
+  std::cout << "run_one ran " << ios.run_one();
+  std::cout << " after " << std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - start).count() << "ms" << std::endl;
+
+  // A frame loop doing bounded work per tick
+  ios.schedule_after(std::chrono::milliseconds(10), [&count] { count++; });
+  for (int frame = 0; frame < 5; frame++)
+  {
+    ios.run_for(std::chrono::milliseconds(4));
+  }
+
+  ios.schedule_after(std::chrono::milliseconds(10), [&ios] { ios.stop(); });
+  ios.run();
+  std::cout << "stopped: " << ios.stopped() << ", handlers: " << count
+            << ", epoll fd valid: " << (ios.native_handle() >= 0) << std::endl;
+  return 0;
+}
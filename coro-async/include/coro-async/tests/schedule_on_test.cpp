@@ -0,0 +1,46 @@
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+static const int num_hops = 100000;
+
+coro_task_auto<void> ping_pong(io_service& a, io_service& b,
+                               std::thread::id a_id, std::thread::id b_id)
+{
+  co_await schedule_on(a);
+  bool on_right_thread = true;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_hops; i++)
+  {
+    co_await schedule_on(b);
+    on_right_thread = on_right_thread && std::this_thread::get_id() == b_id;
+    co_await schedule_on(a);
+    on_right_thread = on_right_thread && std::this_thread::get_id() == a_id;
+  }
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+
+  std::cout << 2 * num_hops << " hops, " << ns / (2 * num_hops)
+            << "ns per hop, on the right threads: " << on_right_thread << std::endl;
+  a.stop();
+  b.stop();
+  co_return;
+}
+
+int main() {
+  io_service a{};
+  io_service b{};
+
+  std::thread ta{[&] { a.run(); }};
+  std::thread tb{[&] { b.run(); }};
+
+  ping_pong(a, b, ta.get_id(), tb.get_id());
+
+  ta.join();
+  tb.join();
+  return 0;
+}
@@ -0,0 +1,86 @@
+#include <iostream>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+static const size_t num_shards = 4;
+static const size_t msgs_per_pair = 20000;
+
+// Each shard owns its slot, so no atomics
+struct shard_state
+{
+  size_t received = 0;
+  size_t next_expected[num_shards] = {0,};
+  bool in_order = true;
+};
+
+int main() {
+  std::vector<std::unique_ptr<io_service>> services;
+  std::vector<io_service*> shards;
+  for (size_t i = 0; i < num_shards; i++)
+  {
+    services.emplace_back(new io_service{});
+    shards.push_back(services.back().get());
+  }
+
+  // More messages per pair than the ring holds,
+  // to exercise the sender side overflow
+  shard_mesh mesh{shards, 1024};
+  shard_state state[num_shards];
+  std::atomic<size_t> finished{0};
+
+  auto on_received = [&](size_t to) {
+    if (++state[to].received == (num_shards - 1) * msgs_per_pair)
+    {
+      if (++finished == num_shards)
+      {
+        for (auto s : shards) s->stop();
+      }
+    }
+  };
+
+  for (size_t from = 0; from < num_shards; from++)
+  {
+    shards[from]->post([&, from] {
+      for (size_t seq = 0; seq < msgs_per_pair; seq++)
+      {
+        for (size_t to = 0; to < num_shards; to++)
+        {
+          if (to == from) continue;
+          auto msg = [&, from, to, seq] {
+            auto& st = state[to];
+            if (st.next_expected[from]++ != seq) st.in_order = false;
+            on_received(to);
+          };
+          mesh.submit_to(from, to, msg);
+        }
+      }
+    });
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (auto s : shards)
+  {
+    threads.emplace_back([s] { s->run(); });
+  }
+  for (auto& t : threads) t.join();
+
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start).count();
+
+  bool in_order = true;
+  size_t total = 0;
+  for (auto& st : state)
+  {
+    in_order = in_order && st.in_order;
+    total += st.received;
+  }
+  std::cout << total << " messages in " << ms << "ms, in order: " << in_order << std::endl;
+  return 0;
+}
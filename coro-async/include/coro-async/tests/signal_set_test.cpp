@@ -0,0 +1,58 @@
+#include <iostream>
+#include <thread>
+#include <signal.h>
+#include <unistd.h>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+coro_task_auto<void> wait_for_signals(coro_signal_set& sigs, io_service& ios)
+{
+  for (int i = 0; i < 2; i++)
+  {
+    auto res = co_await sigs.wait();
+    if (res.is_error())
+    {
+      std::cerr << "wait failed: " << res.error().message() << '\n';
+      co_return;
+    }
+    std::cout << "got signal " << res.result() << std::endl;
+  }
+  std::cout << "draining" << std::endl;
+
+  // A wait still pending when its set goes away is aborted
+  {
+    std::error_code ec{};
+    signal_set usr{ios};
+    usr.add(SIGUSR1, ec);
+    usr.async_wait([&ios](const std::error_code& ec, int) {
+          std::cout << "pending wait aborted: " << (ec.value() == ECANCELED) << std::endl;
+          ios.stop();
+        });
+  }
+  co_return;
+}
+
+int main() {
+  io_service ios{};
+
+  // Block the signals before any other thread starts
+  std::error_code ec{};
+  coro_signal_set sigs{ios, {SIGHUP, SIGTERM}, ec};
+  if (ec)
+  {
+    std::cerr << "add failed: " << ec.message() << std::endl;
+    return 1;
+  }
+
+  wait_for_signals(sigs, ios);
+
+  std::thread thr{[&] { ios.run(); }};
+
+  ::kill(::getpid(), SIGHUP);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ::kill(::getpid(), SIGTERM);
+
+  thr.join();
+  return 0;
+}
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <cstring>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+static const uint16_t port = 18097;
+static const int num_clients = 4;
+
+using loop_type = basic_io_service<single_threaded>;
+
+// SO_REUSEPORT lets the next run bind while the
+// connections of this one are still in TIME_WAIT.
+void listen_on(coro_acceptor& acc, uint16_t port, std::error_code& ec)
+{
+  auto& a = acc.get_underlying_acceptor();
+  if (a.open(AF_INET, ec)) a.set_reuse_port(true, ec);
+  if (!ec) a.bind(endpoint{v4_address{"127.0.0.1"}, port}, ec);
+  if (!ec) a.listen(128, ec);
+}
+
+coro_task_auto<void> handle_client(coro_socket client)
+{
+  char buf[6];
+  auto bref = as_buffer(buf);
+  auto rd = co_await client.read(6, bref);
+  if (!rd.is_error())
+  {
+    bref = as_buffer(buf);
+    co_await client.write(6, bref);
+  }
+  client.close();
+  co_return;
+}
+
+coro_task_auto<void> server_run(coro_acceptor& acc)
+{
+  while ( true )
+  {
+    auto result = co_await acc.accept();
+    if (result.is_error()) co_return;
+    handle_client(std::move(result.result()));
+  }
+  co_return;
+}
+
+coro_task_auto<void> client_run(loop_type& ios, coro_connector& conn, int& echoed, int& done)
+{
+  auto result = co_await conn.connect("127.0.0.1", port);
+  if (!result.is_error())
+  {
+    auto& sock = result.result();
+    char buf[6] = {'H', 'e', 'l', 'l', 'o', '!'};
+    auto bref = as_buffer(buf);
+    co_await sock.write(6, bref);
+
+    char rbuf[6] = {};
+    bref = as_buffer(rbuf);
+    auto rd = co_await sock.read(6, bref);
+    if (!rd.is_error() && std::memcmp(buf, rbuf, 6) == 0) echoed++;
+  }
+
+  if (++done == num_clients) ios.stop();
+  co_return;
+}
+
+int main() {
+  loop_type ios{};
+  coro_acceptor acceptor{ios};
+
+  std::error_code ec{};
+  listen_on(acceptor, port, ec);
+  if (ec)
+  {
+    std::cout << "error: " << ec.message() << std::endl;
+    return -1;
+  }
+  server_run(acceptor);
+
+  coro_connector conn{ios};
+  int echoed = 0;
+  int done = 0;
+  for (int i = 0; i < num_clients; i++)
+  {
+    client_run(ios, conn, echoed, done);
+  }
+
+  ios.run();
+
+  std::cout << "echoed on a single threaded io_service: "
+            << echoed << "/" << num_clients << std::endl;
+  return echoed == num_clients ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+static const int num_threads = 4;
+static const int num_posts = 10000;
+
+// Only ever touched from the strand, so no lock
+static long counter = 0;
+static bool wrapped_ok = true;
+static std::atomic<int> concurrent{0};
+static bool overlapped = false;
+
+coro_task_auto<void> hop(strand& s, std::atomic<int>& hops)
+{
+  co_await resume_on(s);
+  if (!s.running_in_this_thread()) std::cerr << "not on the strand\n";
+  counter++;
+  hops++;
+  co_return;
+}
+
+int main() {
+  io_service ios{scheduling_policy::work_stealing, num_threads};
+  strand s{ios};
+  std::atomic<int> done{0};
+  std::atomic<int> hops{0};
+
+  auto on_done = [&] {
+    if (++done == num_posts + 1)
+    {
+      std::cout << "counter " << counter << ", hops " << hops
+                << ", wrapped ok " << wrapped_ok
+                << ", overlapped " << overlapped << std::endl;
+      ios.stop();
+    }
+  };
+
+  // Post from the loop threads so that the strand
+  // runner and the posters race each other.
+  for (int t = 0; t < num_threads; t++)
+  {
+    ios.post([&, t] {
+      for (int i = t; i < num_posts; i += num_threads)
+      {
+        // Posted as an lvalue: the strand keeps a copy
+        auto task = [&, i] {
+          if (concurrent++ != 0) overlapped = true;
+          counter++;
+          concurrent--;
+          on_done();
+        };
+        s.post(task);
+      }
+    });
+  }
+
+  // A wrapped completion handler
+  auto wrapped = s.wrap([&](const std::error_code& ec, size_t n) {
+    if (!s.running_in_this_thread() || n != 42) wrapped_ok = false;
+    on_done();
+  });
+  ios.post([wrapped]() mutable { wrapped(std::error_code{}, 42); });
+
+  for (int i = 0; i < 100; i++) hop(s, hops);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++)
+  {
+    threads.emplace_back([&] { ios.run(); });
+  }
+  for (auto& t : threads) t.join();
+  return 0;
+}
@@ -0,0 +1,113 @@
+#include <iostream>
+#include <thread>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+// Stop once both the pipe reader and the eventfd waiter are done
+void finished(io_service& ios, int& done)
+{
+  if (++done == 2) ios.stop();
+}
+
+coro_task_auto<void> pipe_writer(coro_stream_descriptor& wr)
+{
+  char buf[5] = {'p', 'i', 'n', 'g', '!'};
+  auto bref = as_buffer(buf);
+  co_await wr.write(5, bref);
+  // EOF for the reader
+  wr.close();
+  co_return;
+}
+
+coro_task_auto<void> pipe_reader(coro_stream_descriptor& rd, io_service& ios, int& done)
+{
+  char buf[5];
+  auto bref = as_buffer(buf);
+  auto res = co_await rd.read(5, bref);
+  if (res.is_error())
+  {
+    std::cerr << "pipe read failed: " << res.error().message() << '\n';
+  }
+  else
+  {
+    std::cout << "pipe: " << std::string(buf, 5) << std::endl;
+  }
+  finished(ios, done);
+  co_return;
+}
+
+coro_task_auto<void> event_waiter(coro_stream_descriptor& efd, io_service& ios, int& done)
+{
+  for (int i = 0; i < 3; i++)
+  {
+    uint64_t count = 0;
+    buffer::buffer_ref bref{reinterpret_cast<char*>(&count), sizeof(count)};
+    auto res = co_await efd.read(sizeof(count), bref);
+    if (res.is_error())
+    {
+      std::cerr << "eventfd read failed: " << res.error().message() << '\n';
+      break;
+    }
+    std::cout << "eventfd signalled, count: " << count << std::endl;
+  }
+  finished(ios, done);
+  co_return;
+}
+
+int main() {
+  io_service ios{};
+  std::error_code ec{};
+
+  int p[2];
+  if (::pipe(p) != 0)
+  {
+    std::cout << "pipe: " << std::strerror(errno) << std::endl;
+    return -1;
+  }
+  coro_stream_descriptor rd{ios}, wr{ios};
+  rd.assign(p[0], ec);
+  wr.assign(p[1], ec);
+
+  int efd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  coro_stream_descriptor ev{ios};
+  ev.assign(efd, ec);
+  if (ec)
+  {
+    std::cout << "error: " << ec.message() << std::endl;
+    return -1;
+  }
+
+  // A read pending on a closed (dup'ed) descriptor is aborted
+  posix_stream_descriptor dup_rd{ios};
+  dup_rd.assign(::dup(p[0]), ec);
+  char dup_buf[1];
+  dup_rd.async_read_some(as_buffer(dup_buf), [](const std::error_code& ec, size_t) {
+        std::cout << "pending read aborted: " << (ec.value() == ECANCELED) << std::endl;
+      });
+  dup_rd.close();
+
+  int done = 0;
+  pipe_reader(rd, ios, done);
+  pipe_writer(wr);
+  event_waiter(ev, ios, done);
+
+  // Signal the loop from another thread
+  std::thread notifier{[efd] {
+    for (int i = 0; i < 3; i++)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      uint64_t one = 1;
+      ::write(efd, &one, sizeof(one));
+    }
+  }};
+
+  std::thread thr{[&] { ios.run(); }};
+  notifier.join();
+  thr.join();
+  return 0;
+}
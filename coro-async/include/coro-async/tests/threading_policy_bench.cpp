@@ -0,0 +1,93 @@
+#include <chrono>
+#include <iostream>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+static const size_t batch = 256;
+static const size_t rounds = 4000;
+
+/// Caller owned, so that the allocator stays out of the numbers
+struct count_op: detail::operation_base
+{
+  count_op()
+    : operation_base(count_op::complete)
+  {
+  }
+
+  static void complete(detail::operation_base* op, const std::error_code&, size_t)
+  {
+    static_cast<count_op*>(op)->calls_++;
+  }
+
+  size_t calls_ = 0;
+};
+
+template <typename Fn>
+static double ns_per_op(Fn&& fn)
+{
+  auto start = std::chrono::steady_clock::now();
+  size_t n = fn();
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+  return n ? static_cast<double>(ns) / n : 0.0;
+}
+
+template <typename Threading>
+static void bench(const char* name)
+{
+  basic_io_service<Threading> ios{};
+
+  // post + run of an operation
+  count_op ops[batch];
+  double post_op_ns = ns_per_op([&] {
+        size_t n = 0;
+        for (size_t r = 0; r < rounds; r++)
+        {
+          for (auto& op : ops) ios.post_op(&op);
+          n += ios.poll();
+        }
+        return n;
+      });
+
+  // post + run of a handler, allocation included
+  size_t posted = 0;
+  double post_ns = ns_per_op([&] {
+        size_t n = 0;
+        for (size_t r = 0; r < rounds; r++)
+        {
+          for (size_t i = 0; i < batch; i++) ios.post([&posted] { posted++; });
+          n += ios.poll();
+        }
+        return n;
+      });
+
+  // add + expiry of a timer
+  size_t fired = 0;
+  double timer_ns = ns_per_op([&] {
+        size_t n = 0;
+        for (size_t r = 0; r < rounds; r++)
+        {
+          for (size_t i = 0; i < batch; i++)
+          {
+            ios.schedule_after(std::chrono::milliseconds(0), [&fired] { fired++; });
+          }
+          n += ios.poll();
+        }
+        return n;
+      });
+
+  std::cout << name << ": post_op " << post_op_ns << " ns/op, post "
+            << post_ns << " ns/op, timer " << timer_ns << " ns/op ("
+            << ops[0].calls_ * batch + posted << " posts, "
+            << fired << " timers)" << std::endl;
+}
+
+int main() {
+  // Warm up
+  bench<multi_threaded>("warm up        ");
+
+  bench<multi_threaded>("multi_threaded ");
+  bench<single_threaded>("single_threaded");
+  return 0;
+}
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <thread>
+#include <cstring>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+// 32 small datagrams and 2 GSO segments
+static const size_t num_datagrams = 34;
+
+coro_task_auto<void> receiver(coro_datagram_socket& sock, io_service& ios)
+{
+  // Large slots so that GRO can coalesce segments
+  datagram_batch batch{16, 65536};
+  size_t total = 0;
+
+  while (true)
+  {
+    auto res = co_await sock.receive_batch(batch);
+    if (res.is_error())
+    {
+      std::cerr << "receive failed: " << res.error().message() << '\n';
+      ios.stop();
+      co_return;
+    }
+
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+      // A GRO message carries length / segment_size datagrams
+      const size_t seg = batch.segment_size(i);
+      total += (batch.length(i) + seg - 1) / seg;
+    }
+    std::cout << "received " << res.result() << " message(s), "
+              << total << " datagram(s) so far" << std::endl;
+
+    if (total >= num_datagrams) break;
+  }
+  ios.stop();
+  co_return;
+}
+
+coro_task_auto<void> sender(coro_datagram_socket& sock, endpoint to, io_service& ios)
+{
+  datagram_batch batch{32, 2048};
+  char payload[64];
+
+  // 32 small datagrams with a single sendmmsg
+  for (int i = 0; i < 32; i++)
+  {
+    int len = ::snprintf(payload, sizeof(payload), "datagram %d", i);
+    batch.push(payload, len, to);
+  }
+  auto res = co_await sock.send_batch(batch);
+  if (res.is_error())
+  {
+    std::cerr << "send failed: " << res.error().message() << '\n';
+    ios.stop();
+    co_return;
+  }
+  std::cout << "sent " << res.result() << " datagram(s)" << std::endl;
+
+  // One GSO message split by the kernel into 2 x 1000 bytes
+  batch.clear();
+  char big[2000];
+  ::memset(big, 'x', sizeof(big));
+  batch.push(big, sizeof(big), to, 1000);
+  res = co_await sock.send_batch(batch);
+  if (res.is_error())
+  {
+    std::cerr << "GSO send failed: " << res.error().message() << '\n';
+    ios.stop();
+    co_return;
+  }
+  std::cout << "sent GSO message" << std::endl;
+  co_return;
+}
+
+int main() {
+  io_service ios{};
+
+  std::error_code ec{};
+  coro_datagram_socket rx{ios};
+  rx.open("127.0.0.1", 9090, ec);
+  if (ec)
+  {
+    std::cout << "error: " << ec.message() << std::endl;
+    return -1;
+  }
+  rx.get_datagram_sock().set_gro(true, ec);
+  if (ec) std::cout << "GRO not supported: " << ec.message() << std::endl;
+
+  coro_datagram_socket tx{ios};
+  tx.open("127.0.0.1", 0, ec);
+  if (ec)
+  {
+    std::cout << "error: " << ec.message() << std::endl;
+    return -1;
+  }
+
+  // A receive pending on a closed socket is aborted
+  datagram_socket idle{ios};
+  idle.bind(endpoint{v4_address{"127.0.0.1"}, 0}, ec);
+  datagram_batch idle_batch{1, 64};
+  idle.async_receive_batch(idle_batch, [](const std::error_code& ec, size_t) {
+        std::cout << "pending receive aborted: " << (ec.value() == ECANCELED) << std::endl;
+      });
+  idle.close();
+  std::cout << "closed socket is open: " << idle.is_open() << std::endl;
+
+  receiver(rx, ios);
+  sender(tx, endpoint{v4_address{"127.0.0.1"}, 9090}, ios);
+
+  std::thread thr{[&] { ios.run(); }};
+  thr.join();
+  return 0;
+}
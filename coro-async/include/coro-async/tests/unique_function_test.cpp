@@ -0,0 +1,91 @@
+#include <new>
+#include <memory>
+#include <cstdlib>
+#include <cstddef>
+#include <iostream>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+static size_t allocs = 0;
+
+// Counts the allocations. The whole set of the replaceable
+// operators is replaced so that news and deletes still pair up.
+static void* counted_alloc(size_t sz, size_t align = 0) noexcept
+{
+  allocs++;
+  if (sz == 0) sz = 1;
+  if (align <= alignof(std::max_align_t)) return std::malloc(sz);
+  return std::aligned_alloc(align, (sz + align - 1) / align * align);
+}
+
+static void* checked(void* p)
+{
+  if (!p) throw std::bad_alloc{};
+  return p;
+}
+
+void* operator new(size_t sz)                 { return checked(counted_alloc(sz)); }
+void* operator new[](size_t sz)               { return checked(counted_alloc(sz)); }
+void* operator new(size_t sz, std::align_val_t al)
+{
+  return checked(counted_alloc(sz, static_cast<size_t>(al)));
+}
+void* operator new[](size_t sz, std::align_val_t al)
+{
+  return checked(counted_alloc(sz, static_cast<size_t>(al)));
+}
+void* operator new(size_t sz, const std::nothrow_t&) noexcept   { return counted_alloc(sz); }
+void* operator new[](size_t sz, const std::nothrow_t&) noexcept { return counted_alloc(sz); }
+
+void operator delete(void* p) noexcept                          { std::free(p); }
+void operator delete[](void* p) noexcept                        { std::free(p); }
+void operator delete(void* p, size_t) noexcept                  { std::free(p); }
+void operator delete[](void* p, size_t) noexcept                { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept        { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept      { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept   { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept   { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+size_t timer_allocs = static_cast<size_t>(-1);
+
+coro_task_auto<void> sleeper(coro_scheduler& sched)
+{
+  // The first one may grow the timer queue
+  co_await sched.yield_for(std::chrono::milliseconds(1));
+
+  const size_t before = allocs;
+  co_await sched.yield_for(std::chrono::milliseconds(1));
+  timer_allocs = allocs - before;
+  co_return;
+}
+
+int main() {
+  io_service ios{};
+  coro_scheduler sched{ios};
+
+  // Move only captures
+  auto val = std::make_unique<int>(0);
+  ios.schedule_after(std::chrono::milliseconds(0), [v = std::move(val)] { *v = 42; });
+
+  // Bigger than the inline storage: goes to the heap
+  struct big { char pad[128]; };
+  bool big_ran = false;
+  const size_t before_big = allocs;
+  ios.schedule_after(std::chrono::milliseconds(0), [b = big{}, &big_ran] { big_ran = true; });
+  const size_t big_allocs = allocs - before_big;
+
+  ios.post([&] { sleeper(sched); });
+  ios.schedule_after(std::chrono::milliseconds(50), [&] { ios.stop(); });
+  ios.run();
+
+  detail::unique_function<int(int)> f = [p = std::make_unique<int>(2)](int x) { return *p * x; };
+  auto g = std::move(f);
+
+  std::cout << "moved: " << !f << ' ' << g(21)
+            << ", big ran: " << big_ran << " (allocated: " << (big_allocs > 0) << ")"
+            << ", allocations by an awaited timer: " << timer_allocs << std::endl;
+  return 0;
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+#include <thread>
+#include <unistd.h>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+// Writes into every descriptor passed to it and closes it
+coro_task_auto<void> handle_client(coro_socket client)
+{
+  while (true)
+  {
+    char buf[4];
+    int fds[4];
+    auto bref = as_buffer(buf);
+    auto res = co_await client.recv_fds(bref, fds, 4);
+    if (res.is_error())
+    {
+      std::cerr << "recv_fds: " << res.error().message() << '\n';
+      break;
+    }
+
+    std::cout << "server got " << res.result().nfds_ << " fd(s)" << std::endl;
+    for (size_t i = 0; i < res.result().nfds_; i++)
+    {
+      ::write(fds[i], "hello via fd\n", 13);
+      ::close(fds[i]);
+    }
+
+    // Ack so that the client knows the pipe got written
+    bref = as_buffer(buf);
+    co_await client.write(bref.size(), bref);
+  }
+  client.close();
+  co_return;
+}
+
+coro_task_auto<void> server_run(coro_local_acceptor& acc)
+{
+  while ( true )
+  {
+    auto result = co_await acc.accept();
+    if (result.is_error())
+    {
+      std::cerr << "Accept failed: " << result.error().message() << '\n';
+      co_return;
+    }
+    handle_client(std::move(result.result()));
+  }
+  co_return;
+}
+
+coro_task_auto<void> client_run(coro_connector& conn, local_endpoint ep, io_service& ios)
+{
+  auto result = co_await conn.connect(ep);
+  if (result.is_error())
+  {
+    std::cerr << "Connect failed: " << result.error().message() << '\n';
+    ios.stop();
+    co_return;
+  }
+  auto& sock = result.result();
+
+  int p[2];
+  ::pipe(p);
+
+  char buf[4] = {'p', 'i', 'p', 'e'};
+  auto bref = as_buffer(buf);
+  auto sent = co_await sock.send_fds(bref, &p[1], 1);
+  if (sent.is_error())
+  {
+    std::cerr << "send_fds: " << sent.error().message() << '\n';
+    ios.stop();
+    co_return;
+  }
+  // The server holds its own copy now
+  ::close(p[1]);
+
+  bref = as_buffer(buf);
+  co_await sock.read(4, bref);
+
+  char out[32] = {0,};
+  ::read(p[0], out, sizeof(out) - 1);
+  ::close(p[0]);
+  std::cout << "client read from pipe: " << out;
+  ios.stop();
+  co_return;
+}
+
+int main() {
+  io_service ios{};
+  coro_local_acceptor acceptor{ios};
+
+  std::error_code ec{};
+  acceptor.open("/tmp/coro_async_fd_test.sock", ec);
+  if (ec)
+  {
+    std::cout << "error: " << ec.message() << std::endl;
+    return -1;
+  }
+  server_run(acceptor);
+
+  coro_connector connector{ios};
+  client_run(connector, local_endpoint{"/tmp/coro_async_fd_test.sock"}, ios);
+
+  std::thread thr{[&] { ios.run(); }};
+  thr.join();
+  return 0;
+}
@@ -0,0 +1,58 @@
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+static const int num_threads = 4;
+static const int num_tasks = 2000;
+
+// Skewed cost: every 10th task is 100x heavier
+static void burn(int i)
+{
+  volatile unsigned long x = 0;
+  const int iters = (i % 10 == 0) ? 100000 : 1000;
+  for (int k = 0; k < iters; k++) x += k;
+}
+
+int main() {
+  io_service ios{scheduling_policy::work_stealing, num_threads};
+
+  std::atomic<int> done{0};
+  std::atomic<int> ran_on[num_threads];
+  for (auto& r : ran_on) r = 0;
+  thread_local int my_index = -1;
+
+  // Seed from inside the loop so that everything lands
+  // on one thread's deque and has to be stolen.
+  ios.post([&] {
+    for (int i = 0; i < num_tasks; i++)
+    {
+      ios.post([&, i] {
+        burn(i);
+        ran_on[my_index]++;
+        if (++done == num_tasks) ios.stop();
+      });
+    }
+  });
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++)
+  {
+    threads.emplace_back([&, t] { my_index = t; ios.run(); });
+  }
+  for (auto& t : threads) t.join();
+
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start).count();
+
+  int busy = 0;
+  for (auto& r : ran_on) busy += (r > 0);
+  std::cout << done << " tasks in " << ms << "ms, "
+            << busy << " of " << num_threads << " threads did work" << std::endl;
+  return 0;
+}
@@ -0,0 +1,59 @@
+#include <iostream>
+#include <thread>
+#include <string>
+#include <unistd.h>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+static const size_t num_writers = 64;
+static const size_t appends_per_writer = 20;
+static size_t writers_done = 0;
+
+coro_task_auto<void> writer(write_ahead_log& wal, size_t id)
+{
+  for (size_t i = 0; i < appends_per_writer; i++)
+  {
+    std::string rec = "writer " + std::to_string(id) + " record " + std::to_string(i) + "\n";
+    auto res = co_await wal.append(buffer::buffer_ref{rec.data(), rec.size()});
+    if (res.is_error())
+    {
+      std::cerr << "append failed: " << res.error().message() << '\n';
+      break;
+    }
+  }
+
+  if (++writers_done == num_writers)
+  {
+    std::cout << num_writers * appends_per_writer << " records in "
+              << wal.commits() << " commits, "
+              << wal.durable_size() << " bytes durable" << std::flush;
+    wal.get_io_service().stop();
+  }
+  co_return;
+}
+
+int main() {
+  io_service ios{};
+  thread_pool pool{1};
+
+  const char* path = "/tmp/coro_async_wal_test.log";
+  ::unlink(path);
+
+  write_ahead_log wal{ios, pool};
+  std::error_code ec{};
+  if (!wal.open(path, ec))
+  {
+    std::cerr << "open failed: " << ec.message() << std::endl;
+    return 1;
+  }
+
+  for (size_t i = 0; i < num_writers; i++)
+  {
+    writer(wal, i);
+  }
+
+  std::thread thr{[&] { ios.run(); }};
+  thr.join();
+  return 0;
+}
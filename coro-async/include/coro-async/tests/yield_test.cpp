@@ -0,0 +1,77 @@
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "coro_async.hpp"
+
+using namespace coro_async;
+
+std::string trace;
+int spins = 0;
+int spins_at_read = -1;
+
+coro_task_auto<void> busy(char tag, int n)
+{
+  for (int i = 0; i < n; i++)
+  {
+    trace += tag;
+    spins++;
+    co_await yield();
+  }
+  co_return;
+}
+
+coro_task_auto<void> reader(coro_socket& sock)
+{
+  char buf[1];
+  auto bref = as_buffer(buf);
+  auto res = co_await sock.read(1, bref);
+  if (!res.is_error()) spins_at_read = spins;
+  co_return;
+}
+
+int main() {
+  // A handler re-posting itself does not keep the timers out
+  {
+    io_service ios{};
+    ios.set_handler_budget(64);
+
+    size_t reposts = 0;
+    std::function<void()> again = [&] { reposts++; ios.post(std::function<void()>{again}); };
+    ios.post(std::function<void()>{again});
+    ios.schedule_after(std::chrono::milliseconds(20), [&] { ios.stop(); });
+    ios.run();
+    std::cout << "timer ran despite the re-posting handler: " << (reposts > 0) << std::endl;
+  }
+
+  // Yielding coroutines take turns, and let the I/O in
+  {
+    io_service ios{};
+    int sv[2];
+    ::socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    coro_socket sock{ios};
+    std::error_code ec{};
+    sock.get_stream_sock().assign(sv[0], ec);
+
+    ios.post([&] {
+          reader(sock);
+          busy('a', 1000);
+          busy('b', 1000);
+        });
+    ios.post([&] { ::write(sv[1], "x", 1); });
+    ios.schedule_after(std::chrono::milliseconds(100), [&] { ios.stop(); });
+    ios.run();
+
+    std::cout << "interleaved: " << trace.substr(0, 8)
+              << ", read completed while spinning: "
+              << (spins_at_read >= 0 && spins_at_read < 2000) << std::endl;
+    ::close(sv[1]);
+  }
+
+  // Not on a loop thread: completes right away
+  {
+    auto t = busy('c', 1);
+    std::cout << "off the loop: " << trace.back() << std::endl;
+  }
+  return 0;
+}
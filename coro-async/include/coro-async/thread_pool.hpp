@@ -0,0 +1,154 @@
+#ifndef CORO_ASYNC_THREAD_POOL_HPP
+#define CORO_ASYNC_THREAD_POOL_HPP
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cassert>
+#include <functional>
+#include <condition_variable>
+
+#include "coro-async/detail/operation_base.hpp"
+#include "coro-async/detail/operation_queue.hpp"
+
+namespace coro_async {
+
+/**
+ * A fixed size pool of threads for running blocking calls
+ * (disk I/O, blocking libraries) off the io_service threads.
+ *
+ * Tasks are run in FIFO order, operations posted with `post_op`
+ * before the tasks. The tasks already queued are still run
+ * when the pool is destroyed.
+ */
+class thread_pool
+{
+public:
+  /**
+   * Constructor.
+   * \param num_threads - Number of worker threads. Bounds the
+   *                      number of blocking calls in flight.
+   */
+  explicit thread_pool(size_t num_threads = 4)
+  {
+    assert (num_threads > 0);
+    workers_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; i++)
+    {
+      workers_.emplace_back([this] { this->worker_loop(); });
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  /// Runs the pending tasks and joins the workers.
+  ~thread_pool()
+  {
+    {
+      std::lock_guard<std::mutex> guard{lock_};
+      stop_ = true;
+    }
+    task_event_.notify_all();
+    for (auto& t : workers_) t.join();
+  }
+
+public:
+  /**
+   * Run `task` on one of the worker threads.
+   * Thread safe.
+   */
+  template <typename Task>
+  void post(Task&& task)
+  {
+    {
+      std::lock_guard<std::mutex> guard{lock_};
+      tasks_.emplace_back(std::forward<Task>(task));
+    }
+    task_event_.notify_one();
+  }
+
+  /**
+   * Run an operation owned by the caller on one of the
+   * worker threads. Does not allocate. The operation is
+   * called with an empty error code.
+   * Thread safe.
+   */
+  void post_op(detail::operation_base* op)
+  {
+    {
+      std::lock_guard<std::mutex> guard{lock_};
+      ops_.push(op);
+    }
+    task_event_.notify_one();
+  }
+
+  /// Number of worker threads
+  size_t size() const noexcept
+  {
+    return workers_.size();
+  }
+
+private:
+  ///
+  void worker_loop()
+  {
+    while (true)
+    {
+      std::function<void()> task;
+      detail::operation_base* op = nullptr;
+      {
+        std::unique_lock<std::mutex> lk{lock_};
+        task_event_.wait(lk, [this] {
+              return stop_ || !tasks_.empty() || !ops_.is_empty();
+            });
+
+        if (!ops_.is_empty())
+        {
+          op = ops_.pop();
+        }
+        else
+        {
+          if (tasks_.empty()) return; // stop_ is set
+
+          task = std::move(tasks_.front());
+          tasks_.pop_front();
+        }
+      }
+
+      if (op)
+      {
+        std::error_code ec{};
+        op->call(op, ec, 0);
+      }
+      else
+      {
+        task();
+      }
+    }
+  }
+
+private:
+  /// The pending tasks
+  std::deque<std::function<void()>> tasks_;
+
+  /// The pending caller owned operations
+  operation_queue<detail::operation_base> ops_;
+
+  /// Lock to protect the task queue
+  std::mutex lock_;
+
+  /// Task available event
+  std::condition_variable task_event_;
+
+  /// Asks the workers to exit
+  bool stop_ = false;
+
+  /// The worker threads
+  std::vector<std::thread> workers_;
+};
+
+} // END namespace coro_async
+
+#endif
@@ -2,10 +2,36 @@
 #include "coro-async/endpoint.hpp"
 #include "coro-async/io_service.hpp"
 #include "coro-async/stream_socket.hpp"
+#include "coro-async/resolver.hpp"
 #include "coro-async/tcp_acceptor.hpp"
+#include "coro-async/local_endpoint.hpp"
+#include "coro-async/local_acceptor.hpp"
+#include "coro-async/datagram_batch.hpp"
+#include "coro-async/datagram_socket.hpp"
+#include "coro-async/posix_stream_descriptor.hpp"
+#include "coro-async/thread_pool.hpp"
+#include "coro-async/async_file.hpp"
+#include "coro-async/signal_set.hpp"
+#include "coro-async/strand.hpp"
+#include "coro-async/shard_mesh.hpp"
+#include "coro-async/accept_distributor.hpp"
+#include "coro-async/cpu_topology.hpp"
+#include "coro-async/shard_group.hpp"
 #include "coro-async/coro_scheduler.hpp"
 #include "coro-async/coro/result.hpp"
 #include "coro-async/coro/coro_task.hpp"
 #include "coro-async/coro/coro_socket.hpp"
 #include "coro-async/coro/coro_acceptor.hpp"
+#include "coro-async/coro/coro_local_acceptor.hpp"
+#include "coro-async/coro/coro_datagram_socket.hpp"
+#include "coro-async/coro/coro_stream_descriptor.hpp"
+#include "coro-async/coro/coro_file.hpp"
+#include "coro-async/coro/write_ahead_log.hpp"
+#include "coro-async/coro/coro_signal_set.hpp"
+#include "coro-async/coro/strand_awaitable.hpp"
+#include "coro-async/coro/offload_awaitable.hpp"
+#include "coro-async/coro/handoff_awaitable.hpp"
 #include "coro-async/coro/coro_connector.hpp"
+#include "coro-async/coro/connection_pool.hpp"
+#include "coro-async/coro/load_balancer.hpp"
+#include "coro-async/coro/coro_resolver.hpp"